@@ -8,14 +8,14 @@
 namespace circuits
 {
 
-ElementId gate_combinatinal(CombinationalGates::GateDesc desc, std::initializer_list<NodeId> in, NodeId out)
+/**
+ * @brief Create an Element Id and Local Id for a new element of a certain type
+ */
+static ElementId create_element(ElemTypeId type)
 {
-    Nodes *pNodes = WipNodes<ELogic>::smt_pNodes;
-    LGRN_ASSERTM(pNodes != nullptr, "No logic nodes in construction");
     LGRN_ASSERTM(t_wipElements != nullptr, "No elements in construction");
-    LGRN_ASSERTM(t_wipGates != nullptr, "No elements in construction");
 
-    PerElemType &rPerType = t_wipElements->m_perType[gc_elemGate];
+    PerElemType &rPerType = t_wipElements->m_perType[type];
 
     // Create Element Id and Local Id
     ElementId const elemId = t_wipElements->m_ids.create();
@@ -23,9 +23,21 @@ ElementId gate_combinatinal(CombinationalGates::GateDesc desc, std::initializer_
 
     // Assign Type and Local ID
     rPerType.m_localToElem[localId] = elemId;
-    t_wipElements->m_elemTypes[elemId] = gc_elemGate;
+    t_wipElements->m_elemTypes[elemId] = type;
     t_wipElements->m_elemToLocal[elemId] = localId;
 
+    return elemId;
+}
+
+ElementId gate_combinatinal(CombinationalGates::GateDesc desc, std::initializer_list<NodeId> in, NodeId out)
+{
+    Nodes *pNodes = WipNodes<ELogic>::smt_pNodes;
+    LGRN_ASSERTM(pNodes != nullptr, "No logic nodes in construction");
+    LGRN_ASSERTM(t_wipGates != nullptr, "No elements in construction");
+
+    ElementId   const elemId  = create_element(gc_elemGate);
+    ElemLocalId const localId = t_wipElements->m_elemToLocal[elemId];
+
     // Assign gate description
     t_wipGates->m_localGates[localId] = desc;
 
@@ -37,11 +49,181 @@ ElementId gate_combinatinal(CombinationalGates::GateDesc desc, std::initializer_
     return elemId;
 }
 
+void gate_delay(ElementId elem, SimTime_t rise, SimTime_t fall)
+{
+    LGRN_ASSERTM(t_wipElements != nullptr, "No elements in construction");
+    LGRN_ASSERTM(t_wipGates != nullptr, "No elements in construction");
+    LGRN_ASSERTM(t_wipElements->m_elemTypes[elem] == gc_elemGate, "Element is not a gate");
+
+    ElemLocalId const localId = t_wipElements->m_elemToLocal[elem];
+    t_wipGates->m_localDelays[localId] = { rise, fall };
+}
+
+ElementId flip_flop_D(NodeId clock, NodeId d, NodeId q)
+{
+    Nodes *pNodes = WipNodes<ELogic>::smt_pNodes;
+    LGRN_ASSERTM(pNodes != nullptr, "No logic nodes in construction");
+    LGRN_ASSERTM(t_wipFlipFlops != nullptr, "No flip-flops in construction");
+
+    FlipFlops &rFlops = *t_wipFlipFlops;
+
+    ElementId   const elemId  = create_element(gc_elemFlipFlop);
+    ElemLocalId const localId = t_wipElements->m_elemToLocal[elemId];
+
+    // Find or create the clock domain
+    ClockDomainId &rDomainId = rFlops.m_clockToDomain[clock];
+    if (rDomainId == lgrn::id_null<ClockDomainId>())
+    {
+        rDomainId = ClockDomainId(rFlops.m_domains.size());
+        rFlops.m_domains.emplace_back().m_clock = clock;
+        rFlops.m_domainsTouched.resize(rFlops.m_domains.size());
+    }
+
+    ClockDomain &rDomain = rFlops.m_domains[rDomainId];
+    rDomain.m_inD.push_back(d);
+    rDomain.m_outQ.push_back(q);
+    rDomain.m_state.resize(lgrn::div_ceil(rDomain.m_inD.size(), 64), 0);
+
+    rFlops.m_localDomain[localId] = rDomainId;
+
+    NodeId *pData = pNodes->m_elemConnect.emplace(elemId, 3);
+    pData[0] = q;
+    pData[1] = clock;
+    pData[2] = d;
+
+    return elemId;
+}
+
+ElementId word_combinational(WordOps::OpDesc desc, std::initializer_list<NodeId> in, NodeId out)
+{
+    Nodes *pWordNodes = WipNodes<std::uint64_t>::smt_pNodes;
+    LGRN_ASSERTM(pWordNodes != nullptr, "No word nodes in construction");
+    LGRN_ASSERTM(t_wipWordOps != nullptr, "No word ops in construction");
+    LGRN_ASSERTM(in.size() >= 2, "Word operations need at least 2 inputs");
+
+    ElementId   const elemId  = create_element(gc_elemWordOp);
+    ElemLocalId const localId = t_wipElements->m_elemToLocal[elemId];
+
+    t_wipWordOps->m_localOps[localId] = desc;
+
+    NodeId *pData = pWordNodes->m_elemConnect.emplace(elemId, in.size() + 1);
+    pData[0] = out;
+    std::copy(std::begin(in), std::end(in), pData + 1);
+
+    return elemId;
+}
+
+ElementId word_MUX(NodeId select, std::initializer_list<NodeId> in, NodeId out, std::uint8_t width)
+{
+    Nodes *pWordNodes = WipNodes<std::uint64_t>::smt_pNodes;
+    LGRN_ASSERTM(pWordNodes != nullptr, "No word nodes in construction");
+    LGRN_ASSERTM(t_wipWordOps != nullptr, "No word ops in construction");
+    LGRN_ASSERTM(in.size() != 0, "Mux needs inputs");
+
+    ElementId   const elemId  = create_element(gc_elemWordOp);
+    ElemLocalId const localId = t_wipElements->m_elemToLocal[elemId];
+
+    t_wipWordOps->m_localOps[localId] = { WordOps::Op::MUX, width };
+
+    NodeId *pData = pWordNodes->m_elemConnect.emplace(elemId, in.size() + 2);
+    pData[0] = out;
+    pData[1] = select;
+    std::copy(std::begin(in), std::end(in), pData + 2);
+
+    return elemId;
+}
+
+ElementId bit_select(NodeId word, std::uint8_t bit, NodeId out)
+{
+    Nodes *pWordNodes   = WipNodes<std::uint64_t>::smt_pNodes;
+    Nodes *pLogicNodes  = WipNodes<ELogic>::smt_pNodes;
+    LGRN_ASSERTM(pWordNodes != nullptr && pLogicNodes != nullptr, "No nodes in construction");
+    LGRN_ASSERTM(t_wipWordBits != nullptr, "No word bits in construction");
+    LGRN_ASSERTMV(bit < 64, "Bit out of range", bit);
+
+    ElementId   const elemId  = create_element(gc_elemBitSelect);
+    ElemLocalId const localId = t_wipElements->m_elemToLocal[elemId];
+
+    t_wipWordBits->m_selectBit[localId] = bit;
+
+    pWordNodes->m_elemConnect.emplace(elemId, {lgrn::id_null<NodeId>(), word});
+    pLogicNodes->m_elemConnect.emplace(elemId, {out});
+
+    return elemId;
+}
+
+ElementId bit_merge(std::initializer_list<NodeId> bits, NodeId out)
+{
+    Nodes *pWordNodes   = WipNodes<std::uint64_t>::smt_pNodes;
+    Nodes *pLogicNodes  = WipNodes<ELogic>::smt_pNodes;
+    LGRN_ASSERTM(pWordNodes != nullptr && pLogicNodes != nullptr, "No nodes in construction");
+    LGRN_ASSERTMV(bits.size() <= 64, "Too many bits", bits.size());
+
+    ElementId const elemId = create_element(gc_elemBitMerge);
+
+    pWordNodes->m_elemConnect.emplace(elemId, {out});
+
+    NodeId *pData = pLogicNodes->m_elemConnect.emplace(elemId, bits.size() + 1);
+    pData[0] = lgrn::id_null<NodeId>();
+    std::copy(std::begin(bits), std::end(bits), pData + 1);
+
+    return elemId;
+}
+
+MemoryId memory_block(std::vector<std::uint64_t> words)
+{
+    LGRN_ASSERTM(t_wipMemories != nullptr, "No memories in construction");
+
+    MemoryId const blockId = MemoryId(t_wipMemories->m_blocks.size());
+    t_wipMemories->m_blocks.emplace_back().m_words = std::move(words);
+    return blockId;
+}
+
+ElementId memory_read(MemoryId block, NodeId addr, NodeId out)
+{
+    Nodes *pWordNodes = WipNodes<std::uint64_t>::smt_pNodes;
+    LGRN_ASSERTM(pWordNodes != nullptr, "No word nodes in construction");
+    LGRN_ASSERTM(t_wipMemories != nullptr, "No memories in construction");
+
+    ElementId   const elemId  = create_element(gc_elemMemoryRead);
+    ElemLocalId const localId = t_wipElements->m_elemToLocal[elemId];
+
+    t_wipMemories->m_readToBlock[localId] = block;
+    t_wipMemories->m_blocks[block].m_readPorts.push_back(localId);
+
+    pWordNodes->m_elemConnect.emplace(elemId, {out, addr});
+
+    return elemId;
+}
+
+ElementId memory_write(MemoryId block, NodeId clock, NodeId writeEnable, NodeId addr, NodeId data)
+{
+    Nodes *pWordNodes   = WipNodes<std::uint64_t>::smt_pNodes;
+    Nodes *pLogicNodes  = WipNodes<ELogic>::smt_pNodes;
+    LGRN_ASSERTM(pWordNodes != nullptr && pLogicNodes != nullptr, "No nodes in construction");
+    LGRN_ASSERTM(t_wipMemories != nullptr, "No memories in construction");
+
+    ElementId   const elemId  = create_element(gc_elemMemoryWrite);
+    ElemLocalId const localId = t_wipElements->m_elemToLocal[elemId];
+
+    t_wipMemories->m_writePorts[localId] = { block };
+
+    pWordNodes->m_elemConnect.emplace(elemId, {lgrn::id_null<NodeId>(), addr, data});
+    pLogicNodes->m_elemConnect.emplace(elemId, {lgrn::id_null<NodeId>(), clock, writeEnable});
+
+    return elemId;
+}
+
 void populate_pub_sub(Elements const& elements, Nodes &rNodes)
 {
     std::vector<int> nodeSubCount(rNodes.m_nodeIds.capacity(), 0); // can we reach 1 million subscribers?
     for (ElementId elem : elements.m_ids)
     {
+        if ( ! rNodes.m_elemConnect.contains(elem) )
+        {
+            continue;
+        }
+
         auto nodes = rNodes.m_elemConnect[elem];
         // skip first, port 0 is the publisher
         for (auto it = nodes.begin() + 1; it != nodes.end(); ++it)
@@ -57,6 +239,11 @@ void populate_pub_sub(Elements const& elements, Nodes &rNodes)
     // assign publishers and subscribers
     for (ElementId elem : elements.m_ids.bitview().zeros())
     {
+        if ( ! rNodes.m_elemConnect.contains(elem) )
+        {
+            continue;
+        }
+
         auto nodes = rNodes.m_elemConnect[elem];
         for (auto it = nodes.begin() + 1; it != nodes.end(); ++it)
         {
@@ -71,8 +258,11 @@ void populate_pub_sub(Elements const& elements, Nodes &rNodes)
             rNodes.m_nodeSubscribers[*it][rSubCount] = {local, type};
         }
 
-        // assign publisher
-        rNodes.m_nodePublisher[nodes[0]] = elem;
+        // assign publisher, if this element outputs to these nodes
+        if (nodes[0] != lgrn::id_null<NodeId>())
+        {
+            rNodes.m_nodePublisher[nodes[0]] = elem;
+        }
     }
 }
 
@@ -20,6 +20,10 @@ struct WipNodes
 
 inline thread_local Elements *t_wipElements{nullptr};
 inline thread_local CombinationalGates *t_wipGates{nullptr};
+inline thread_local FlipFlops *t_wipFlipFlops{nullptr};
+inline thread_local WordOps *t_wipWordOps{nullptr};
+inline thread_local WordBits *t_wipWordBits{nullptr};
+inline thread_local Memories *t_wipMemories{nullptr};
 
 template <std::size_t N, typename VALUE_T>
 std::array<NodeId, N> create_nodes() noexcept
@@ -62,6 +66,95 @@ inline ElementId gate_XOR2(std::initializer_list<NodeId> in, NodeId out)
 inline ElementId gate_XNOR2(std::initializer_list<NodeId> in, NodeId out)
 { return gate_combinatinal({ CombinationalGates::Op::XOR2, true }, in, out); }
 
+/**
+ * @brief Set rise and fall delays of a gate, used by timed simulation. Defaults to 1 tick each.
+ */
+void gate_delay(ElementId elem, SimTime_t rise, SimTime_t fall);
+
+//-----------------------------------------------------------------------------
+
+// Sequential
+
+/**
+ * @brief Add a rising-edge D Flip-flop. Flops sharing the same clock node are updated together.
+ */
+ElementId flip_flop_D(NodeId clock, NodeId d, NodeId q);
+
+/**
+ * @brief Add a register as multiple D Flip-flops sharing a clock
+ */
+inline void register_D(NodeId clock, std::initializer_list<NodeId> d, std::initializer_list<NodeId> q)
+{
+    LGRN_ASSERTM(d.size() == q.size(), "Register needs the same number of inputs and outputs");
+    for (std::size_t i = 0; i < d.size(); ++i)
+    {
+        flip_flop_D(clock, *(d.begin() + i), *(q.begin() + i));
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+// Words
+
+ElementId word_combinational(WordOps::OpDesc desc, std::initializer_list<NodeId> in, NodeId out);
+
+inline ElementId word_ADD(NodeId a, NodeId b, NodeId out, std::uint8_t width = 64)
+{ return word_combinational({ WordOps::Op::ADD, width }, {a, b}, out); }
+
+inline ElementId word_SUB(NodeId a, NodeId b, NodeId out, std::uint8_t width = 64)
+{ return word_combinational({ WordOps::Op::SUB, width }, {a, b}, out); }
+
+inline ElementId word_AND(NodeId a, NodeId b, NodeId out, std::uint8_t width = 64)
+{ return word_combinational({ WordOps::Op::AND, width }, {a, b}, out); }
+
+inline ElementId word_OR(NodeId a, NodeId b, NodeId out, std::uint8_t width = 64)
+{ return word_combinational({ WordOps::Op::OR, width }, {a, b}, out); }
+
+inline ElementId word_XOR(NodeId a, NodeId b, NodeId out, std::uint8_t width = 64)
+{ return word_combinational({ WordOps::Op::XOR, width }, {a, b}, out); }
+
+inline ElementId word_SHL(NodeId a, NodeId amount, NodeId out, std::uint8_t width = 64)
+{ return word_combinational({ WordOps::Op::SHL, width }, {a, amount}, out); }
+
+inline ElementId word_SHR(NodeId a, NodeId amount, NodeId out, std::uint8_t width = 64)
+{ return word_combinational({ WordOps::Op::SHR, width }, {a, amount}, out); }
+
+inline ElementId word_EQ(NodeId a, NodeId b, NodeId out)
+{ return word_combinational({ WordOps::Op::EQ, 1 }, {a, b}, out); }
+
+inline ElementId word_LT(NodeId a, NodeId b, NodeId out)
+{ return word_combinational({ WordOps::Op::LT, 1 }, {a, b}, out); }
+
+/**
+ * @brief Select one of the inputs by index. Outputs 0 if select is out of range.
+ */
+ElementId word_MUX(NodeId select, std::initializer_list<NodeId> in, NodeId out, std::uint8_t width = 64);
+
+/**
+ * @brief Output a single bit of a word node to a logic node
+ */
+ElementId bit_select(NodeId word, std::uint8_t bit, NodeId out);
+
+/**
+ * @brief Pack logic nodes into a word node, lowest bit first
+ */
+ElementId bit_merge(std::initializer_list<NodeId> bits, NodeId out);
+
+/**
+ * @brief Add a memory block, accessed with memory_read and memory_write
+ *
+ * @param words [in] Initial contents, which also sets the size
+ */
+MemoryId memory_block(std::vector<std::uint64_t> words);
+
+ElementId memory_read(MemoryId block, NodeId addr, NodeId out);
+
+ElementId memory_write(MemoryId block, NodeId clock, NodeId writeEnable, NodeId addr, NodeId data);
+
+/**
+ * @brief Connect publishers and subscribers of a node type. Elements with no connections to
+ *        these nodes, or an id_null output (port 0), are skipped.
+ */
 void populate_pub_sub(Elements const& elements, Nodes &rNodes);
 
 
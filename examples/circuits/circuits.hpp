@@ -8,6 +8,9 @@
 #include <longeron/id_management/id_set_stl.hpp>
 #include <longeron/id_management/keyed_vec_stl.hpp>
 #include <longeron/id_management/registry_stl.hpp>
+#include <longeron/utility/bitmath.hpp>
+
+#include "timing_wheel.hpp"
 
 #include <algorithm>
 #include <vector>
@@ -20,6 +23,8 @@ namespace circuits
 // preventing logic errors and cognative load from accidentally mixing them up.
 enum class ElemLocalId : std::uint32_t { };
 enum class ElemTypeId  : std::uint8_t  { };
+enum class ClockDomainId : std::uint32_t { };
+enum class MemoryId    : std::uint32_t { };
 
 // lgrn::IntArrayMultiMap does not (yet?) support strongly typedefed ID types
 using ElementId = std::uint32_t;
@@ -66,7 +71,8 @@ struct Nodes
     // reminder: IntArrayMultiMap is kind of like an
     //           std::vector< std::vector<...> > but more memory efficient
     using Subscribers_t = lgrn::IntArrayMultiMap<NodeId, ElementPair>;
-    using Connections_t = lgrn::IntArrayMultiMap<ElementId, NodeId>;
+    // Most elements are 2-input gates with 3 ports, store these inline to avoid an indirection
+    using Connections_t = lgrn::IntArrayMultiMap<ElementId, NodeId, std::allocator<NodeId>, 3>;
 
     lgrn::IdRegistryStl<NodeId>             m_nodeIds;
 
@@ -111,9 +117,196 @@ struct CombinationalGates
         bool m_invert;
     };
 
+    /**
+     * @brief Propagation delays used by timed simulation, in ticks
+     */
+    struct GateDelay
+    {
+        SimTime_t m_rise{1};
+        SimTime_t m_fall{1};
+    };
+
     lgrn::KeyedVec<ElemLocalId, GateDesc> m_localGates;
+    lgrn::KeyedVec<ElemLocalId, GateDelay> m_localDelays;
+};
+
+/**
+ * @brief Flip-flops that all sample on the rising edge of the same clock node
+ *
+ * D and Q nodes are copied out of element connections so a whole domain can be updated by
+ * walking contiguous arrays. Stored Q values are packed into bits, 64 flops per word.
+ */
+struct ClockDomain
+{
+    NodeId                      m_clock;
+    ELogic                      m_clockPrev{ELogic::Low};
+
+    std::vector<NodeId>         m_inD;
+    std::vector<NodeId>         m_outQ;
+    std::vector<std::uint64_t>  m_state;
+};
+
+/**
+ * @brief D Flip-flops, grouped into clock domains
+ *
+ * Ports are: 0 = Q output, 1 = Clock, 2 = D input
+ */
+struct FlipFlops
+{
+    lgrn::KeyedVec<ElemLocalId, ClockDomainId>  m_localDomain;
+
+    lgrn::KeyedVec<ClockDomainId, ClockDomain>  m_domains;
+    lgrn::KeyedVec<NodeId, ClockDomainId>       m_clockToDomain;
+
+    // Domains with dirty flops, used only within update_flip_flops
+    lgrn::IdSetStl<ClockDomainId>               m_domainsTouched;
 };
 
+/**
+ * @brief Evaluate a single combinational gate
+ *
+ * @param inFirst, inLast   Range of input nodes
+ * @param is_high           Callable as bool(NodeId)
+ */
+template <typename IT_T, typename FUNC_T>
+constexpr ELogic eval_gate(CombinationalGates::GateDesc desc, IT_T inFirst, IT_T inLast, FUNC_T&& is_high) noexcept
+{
+    using Op = CombinationalGates::Op;
+
+    bool value = false;
+    switch (desc.m_op)
+    {
+    case Op::AND:
+        value = std::all_of(inFirst, inLast, is_high);
+        break;
+    case Op::OR:
+        value = std::any_of(inFirst, inLast, is_high);
+        break;
+    case Op::XOR:
+        value = std::count_if(inFirst, inLast, is_high) == 1;
+        break;
+    case Op::XOR2:
+        value = (std::count_if(inFirst, inLast, is_high) & 1) == 1;
+        break;
+    }
+
+    value ^= desc.m_invert;
+
+    return value ? ELogic::High : ELogic::Low;
+}
+
+//-----------------------------------------------------------------------------
+
+// Word (multi-bit bus) support
+
+/**
+ * @brief Mask for the lowest 'width' bits of a word
+ */
+constexpr std::uint64_t word_mask(unsigned int width) noexcept
+{
+    return (width >= 64) ? ~std::uint64_t(0) : ((std::uint64_t(1) << width) - 1);
+}
+
+/**
+ * @brief Word-level operations on buses, where each node value is a whole uint64_t
+ *
+ * Ports are: 0 = output, 1 = A, 2 = B. For MUX, A is the select and the rest are data inputs.
+ * Results are masked to m_width bits. EQ and LT output 0 or 1.
+ */
+struct WordOps
+{
+    enum class Op : uint8_t { ADD, SUB, AND, OR, XOR, SHL, SHR, EQ, LT, MUX };
+
+    struct OpDesc
+    {
+        Op              m_op;
+        std::uint8_t    m_width;
+    };
+
+    lgrn::KeyedVec<ElemLocalId, OpDesc> m_localOps;
+};
+
+/**
+ * @brief Bridges between logic and word nodes
+ *
+ * * Bit select: Word port 1 = input word, Logic port 0 = output bit
+ * * Bit merge:  Word port 0 = output word, Logic ports 1... = input bits, lowest first
+ *
+ * Elements that don't output to a node type use id_null for port 0.
+ */
+struct WordBits
+{
+    lgrn::KeyedVec<ElemLocalId, std::uint8_t> m_selectBit;
+};
+
+/**
+ * @brief Memory blocks, accessed through separate read and write port elements
+ *
+ * A ROM is a block with only read ports, RAM adds a write port, and a register file is a block
+ * with multiple read ports.
+ *
+ * * Read port:  Word ports 0 = data out, 1 = address. Reads are combinational.
+ * * Write port: Word ports 1 = address, 2 = data in; Logic ports 1 = clock, 2 = write enable.
+ *               Writes on the rising clock edge while write enable is high.
+ */
+struct Memories
+{
+    struct Block
+    {
+        std::vector<std::uint64_t>  m_words;
+
+        // Read ports to update after a write
+        std::vector<ElemLocalId>    m_readPorts;
+    };
+
+    struct WritePort
+    {
+        MemoryId    m_block;
+        ELogic      m_clockPrev{ELogic::Low};
+    };
+
+    lgrn::KeyedVec<MemoryId, Block>         m_blocks;
+    lgrn::KeyedVec<ElemLocalId, MemoryId>   m_readToBlock;
+    lgrn::KeyedVec<ElemLocalId, WritePort>  m_writePorts;
+};
+
+/**
+ * @brief Evaluate a single word operation
+ *
+ * @param inFirst, inLast   Range of input nodes, at least 2
+ * @param value_of          Callable as std::uint64_t(NodeId)
+ */
+template <typename IT_T, typename FUNC_T>
+constexpr std::uint64_t eval_word_op(WordOps::OpDesc desc, IT_T inFirst, IT_T inLast, FUNC_T&& value_of) noexcept
+{
+    using Op = WordOps::Op;
+
+    std::uint64_t const a = value_of(*inFirst);
+    std::uint64_t const b = value_of(*std::next(inFirst));
+
+    std::uint64_t value = 0;
+    switch (desc.m_op)
+    {
+    case Op::ADD: value = a + b;                        break;
+    case Op::SUB: value = a - b;                        break;
+    case Op::AND: value = a & b;                        break;
+    case Op::OR:  value = a | b;                        break;
+    case Op::XOR: value = a ^ b;                        break;
+    case Op::SHL: value = (b >= 64) ? 0 : (a << b);     break;
+    case Op::SHR: value = (b >= 64) ? 0 : (a >> b);     break;
+    case Op::EQ:  value = (a == b);                     break;
+    case Op::LT:  value = (a < b);                      break;
+    case Op::MUX:
+    {
+        auto const dataCount = std::uint64_t(std::distance(inFirst, inLast) - 1);
+        value = (a < dataCount) ? value_of(*std::next(inFirst, std::ptrdiff_t(1 + a))) : 0;
+        break;
+    }
+    }
+
+    return value & word_mask(desc.m_width);
+}
+
 //-----------------------------------------------------------------------------
 
 // Updating
@@ -161,8 +354,6 @@ bool update_combinational(
         CombinationalGates            const &gates,
         UpdateNodes<ELogic>                 &rUpdNodes) noexcept
 {
-    using Op = CombinationalGates::Op;
-
     auto const is_logic_high = [&nodeValues] (NodeId in) noexcept -> bool
     {
         return nodeValues[in] == ELogic::High;
@@ -176,30 +367,9 @@ bool update_combinational(
         CombinationalGates::GateDesc const &desc = gates.m_localGates[local];
 
         auto connectedNodes = elemConnect[elem];
-        auto inFirst = connectedNodes.begin() + 1;
-        auto inLast  = connectedNodes.end();
 
         // Read input nodes and compute operation
-        bool value;
-        switch (desc.m_op)
-        {
-        case Op::AND:
-            value = std::all_of(inFirst, inLast, is_logic_high);
-            break;
-        case Op::OR:
-            value = std::any_of(inFirst, inLast, is_logic_high);
-            break;
-        case Op::XOR:
-            value = std::count_if(inFirst, inLast, is_logic_high) == 1;
-            break;
-        case Op::XOR2:
-            value = (std::count_if(inFirst, inLast, is_logic_high) & 1) == 1;
-            break;
-        }
-
-        value ^= desc.m_invert;
-
-        ELogic const outLogic = value ? ELogic::High : ELogic::Low;
+        ELogic const outLogic = eval_gate(desc, connectedNodes.begin() + 1, connectedNodes.end(), is_logic_high);
 
         NodeId out = *connectedNodes.begin();
 
@@ -215,6 +385,280 @@ bool update_combinational(
     return nodeUpdated;
 }
 
+/**
+ * @brief Update D Flip-flops and request node changes
+ *
+ * Dirty flops are only used to find which clock domains to check. Each domain that sees a rising
+ * edge is then updated as a whole: D inputs are packed 64 at a time and compared against stored
+ * state, and only flops whose value changed write to their Q node.
+ *
+ * @param[in] toUpdate      Iterable range of flip-flop local IDs to update
+ * @param[in] nodeValues    Values of logic nodes
+ * @param[in] rFlops        Flip-flop data and state
+ * @param[out] rUpdNodes    Node changes out
+ *
+ * @return true if any node changes are written
+ */
+template <typename RANGE_T>
+bool update_flip_flops(
+        RANGE_T&&                           toUpdate,
+        lgrn::KeyedVec<NodeId, ELogic> const &nodeValues,
+        FlipFlops                           &rFlops,
+        UpdateNodes<ELogic>                 &rUpdNodes)
+{
+    for (ElemLocalId local : toUpdate)
+    {
+        rFlops.m_domainsTouched.insert(rFlops.m_localDomain[local]);
+    }
+
+    bool nodeUpdated = false;
+
+    for (ClockDomainId domainId : rFlops.m_domainsTouched)
+    {
+        ClockDomain &rDomain = rFlops.m_domains[domainId];
+
+        ELogic const clock = nodeValues[rDomain.m_clock];
+        bool const risingEdge = (rDomain.m_clockPrev == ELogic::Low) && (clock == ELogic::High);
+        rDomain.m_clockPrev = clock;
+
+        if ( ! risingEdge )
+        {
+            continue; // Only D changed, or falling edge
+        }
+
+        std::size_t const count = rDomain.m_inD.size();
+        for (std::size_t word = 0; word < rDomain.m_state.size(); ++word)
+        {
+            std::size_t const first = word * 64;
+            std::size_t const last  = std::min(count, first + 64);
+
+            std::uint64_t sampled = 0;
+            for (std::size_t i = first; i < last; ++i)
+            {
+                sampled |= std::uint64_t(nodeValues[rDomain.m_inD[i]] == ELogic::High) << (i - first);
+            }
+
+            std::uint64_t changed = sampled ^ rDomain.m_state[word];
+            rDomain.m_state[word] = sampled;
+
+            while (changed != 0)
+            {
+                int const bit = lgrn::ctz(changed);
+                changed &= changed - 1;
+
+                NodeId const out = rDomain.m_outQ[first + bit];
+                rUpdNodes.m_nodeDirty.insert(out);
+                rUpdNodes.m_nodeNewValues[out] = lgrn::bit_test(sampled, bit) ? ELogic::High : ELogic::Low;
+                nodeUpdated = true;
+            }
+        }
+    }
+
+    rFlops.m_domainsTouched.clear();
+
+    return nodeUpdated;
+}
+
+/**
+ * @brief Update word operations and request node changes
+ *
+ * Same as update_combinational, but for word nodes
+ */
+template <typename RANGE_T>
+bool update_word_ops(
+        RANGE_T&&                                   toUpdate,
+        lgrn::KeyedVec<ElemLocalId, ElementId> const &localToElem,
+        Nodes::Connections_t                  const &wordConnect,
+        lgrn::KeyedVec<NodeId, std::uint64_t> const &wordValues,
+        WordOps                               const &ops,
+        UpdateNodes<std::uint64_t>                  &rUpdWords) noexcept
+{
+    auto const value_of = [&wordValues] (NodeId in) noexcept -> std::uint64_t
+    {
+        return wordValues[in];
+    };
+
+    bool nodeUpdated = false;
+
+    for (ElemLocalId local : toUpdate)
+    {
+        ElementId const elem    = localToElem[local];
+        auto connectedNodes     = wordConnect[elem];
+
+        std::uint64_t const value = eval_word_op(ops.m_localOps[local],
+                                                 connectedNodes.begin() + 1, connectedNodes.end(), value_of);
+
+        NodeId const out = *connectedNodes.begin();
+        if (wordValues[out] != value)
+        {
+            nodeUpdated = true;
+            rUpdWords.m_nodeDirty.insert(out);
+            rUpdWords.m_nodeNewValues[out] = value;
+        }
+    }
+
+    return nodeUpdated;
+}
+
+/**
+ * @brief Update bit select elements, reading a single bit of a word node into a logic node
+ */
+template <typename RANGE_T>
+bool update_bit_select(
+        RANGE_T&&                                   toUpdate,
+        lgrn::KeyedVec<ElemLocalId, ElementId> const &localToElem,
+        Nodes::Connections_t                  const &wordConnect,
+        Nodes::Connections_t                  const &logicConnect,
+        lgrn::KeyedVec<NodeId, std::uint64_t> const &wordValues,
+        lgrn::KeyedVec<NodeId, ELogic>        const &logicValues,
+        WordBits                              const &bits,
+        UpdateNodes<ELogic>                         &rUpdLogic) noexcept
+{
+    bool nodeUpdated = false;
+
+    for (ElemLocalId local : toUpdate)
+    {
+        ElementId const elem = localToElem[local];
+        NodeId    const in   = wordConnect[elem][1];
+        NodeId    const out  = logicConnect[elem][0];
+
+        ELogic const value = lgrn::bit_test(wordValues[in], bits.m_selectBit[local]) ? ELogic::High : ELogic::Low;
+        if (logicValues[out] != value)
+        {
+            nodeUpdated = true;
+            rUpdLogic.m_nodeDirty.insert(out);
+            rUpdLogic.m_nodeNewValues[out] = value;
+        }
+    }
+
+    return nodeUpdated;
+}
+
+/**
+ * @brief Update bit merge elements, packing logic nodes into a word node
+ */
+template <typename RANGE_T>
+bool update_bit_merge(
+        RANGE_T&&                                   toUpdate,
+        lgrn::KeyedVec<ElemLocalId, ElementId> const &localToElem,
+        Nodes::Connections_t                  const &wordConnect,
+        Nodes::Connections_t                  const &logicConnect,
+        lgrn::KeyedVec<NodeId, std::uint64_t> const &wordValues,
+        lgrn::KeyedVec<NodeId, ELogic>        const &logicValues,
+        UpdateNodes<std::uint64_t>                  &rUpdWords) noexcept
+{
+    bool nodeUpdated = false;
+
+    for (ElemLocalId local : toUpdate)
+    {
+        ElementId const elem = localToElem[local];
+        auto const inBits    = logicConnect[elem];
+        NodeId    const out  = wordConnect[elem][0];
+
+        std::uint64_t value = 0;
+        for (std::size_t i = 1; i < inBits.size(); ++i)
+        {
+            value |= std::uint64_t(logicValues[inBits[i]] == ELogic::High) << (i - 1);
+        }
+
+        if (wordValues[out] != value)
+        {
+            nodeUpdated = true;
+            rUpdWords.m_nodeDirty.insert(out);
+            rUpdWords.m_nodeNewValues[out] = value;
+        }
+    }
+
+    return nodeUpdated;
+}
+
+/**
+ * @brief Update memory read ports. Out of range addresses read 0.
+ */
+template <typename RANGE_T>
+bool update_memory_read(
+        RANGE_T&&                                   toUpdate,
+        lgrn::KeyedVec<ElemLocalId, ElementId> const &localToElem,
+        Nodes::Connections_t                  const &wordConnect,
+        lgrn::KeyedVec<NodeId, std::uint64_t> const &wordValues,
+        Memories                              const &memories,
+        UpdateNodes<std::uint64_t>                  &rUpdWords) noexcept
+{
+    bool nodeUpdated = false;
+
+    for (ElemLocalId local : toUpdate)
+    {
+        ElementId const elem    = localToElem[local];
+        auto const ports        = wordConnect[elem];
+        std::uint64_t const addr = wordValues[ports[1]];
+
+        std::vector<std::uint64_t> const &words = memories.m_blocks[memories.m_readToBlock[local]].m_words;
+        std::uint64_t const value = (addr < words.size()) ? words[std::size_t(addr)] : 0;
+
+        NodeId const out = ports[0];
+        if (wordValues[out] != value)
+        {
+            nodeUpdated = true;
+            rUpdWords.m_nodeDirty.insert(out);
+            rUpdWords.m_nodeNewValues[out] = value;
+        }
+    }
+
+    return nodeUpdated;
+}
+
+/**
+ * @brief Update memory write ports, writing on rising clock edges
+ *
+ * @param[out] rUpdReadPorts    Read ports of written blocks are marked dirty
+ *
+ * @return true if any read ports were notified
+ */
+template <typename RANGE_T>
+bool update_memory_write(
+        RANGE_T&&                                   toUpdate,
+        lgrn::KeyedVec<ElemLocalId, ElementId> const &localToElem,
+        Nodes::Connections_t                  const &wordConnect,
+        Nodes::Connections_t                  const &logicConnect,
+        lgrn::KeyedVec<NodeId, std::uint64_t> const &wordValues,
+        lgrn::KeyedVec<NodeId, ELogic>        const &logicValues,
+        Memories                                    &rMemories,
+        UpdateElem                                  &rUpdReadPorts)
+{
+    bool elemNotified = false;
+
+    for (ElemLocalId local : toUpdate)
+    {
+        ElementId const elem            = localToElem[local];
+        auto const wordPorts            = wordConnect[elem];
+        auto const logicPorts           = logicConnect[elem];
+        Memories::WritePort &rPort      = rMemories.m_writePorts[local];
+
+        ELogic const clock = logicValues[logicPorts[1]];
+        bool const risingEdge = (rPort.m_clockPrev == ELogic::Low) && (clock == ELogic::High);
+        rPort.m_clockPrev = clock;
+
+        if ( ! risingEdge || logicValues[logicPorts[2]] != ELogic::High )
+        {
+            continue;
+        }
+
+        Memories::Block &rBlock = rMemories.m_blocks[rPort.m_block];
+        std::uint64_t const addr = wordValues[wordPorts[1]];
+        if (addr < rBlock.m_words.size())
+        {
+            rBlock.m_words[std::size_t(addr)] = wordValues[wordPorts[2]];
+            for (ElemLocalId readPort : rBlock.m_readPorts)
+            {
+                rUpdReadPorts.m_localDirty.insert(readPort);
+                elemNotified = true;
+            }
+        }
+    }
+
+    return elemNotified;
+}
+
 /**
  * @brief Update node values and notify subscribed Elements
  *
@@ -253,6 +697,149 @@ bool update_nodes(
     return elemNotified;
 }
 
-constexpr auto const gc_elemGate = ElemTypeId(0);
+//-----------------------------------------------------------------------------
+
+// Timed simulation
+
+/**
+ * @brief A node changing value at a scheduled time
+ */
+struct NodeEvent
+{
+    NodeId          m_node;
+    ELogic          m_value;
+
+    // Must match UpdateTimed::m_nodeGeneration when taken, or else the event was superseded
+    std::uint32_t   m_generation;
+};
+
+/**
+ * @brief Pending node changes for timed simulation, where each gate has its own delays
+ *
+ * Instead of all gates taking a single step, gate outputs are scheduled to change some number of
+ * ticks in the future. Only events of the current time are applied to nodes.
+ *
+ * Delays are inertial: scheduling a node cancels all of its pending events, so only the latest
+ * one is applied. With unequal rise and fall delays, a later event may be scheduled for an
+ * earlier time, and pulses shorter than a gate's delay are filtered out.
+ */
+struct UpdateTimed
+{
+    TimingWheel<NodeEvent>                  m_wheel;
+
+    // Value each node will have once its latest scheduled event is applied
+    lgrn::KeyedVec<NodeId, ELogic>          m_nodeProjected;
+
+    // Incremented each time a node is scheduled, used to skip cancelled events
+    lgrn::KeyedVec<NodeId, std::uint32_t>   m_nodeGeneration;
+
+    // Events taken from m_wheel for the current time
+    std::vector<NodeEvent>                  m_current;
+
+    void assign(SimTime_t time, NodeId node, ELogic value)
+    {
+        std::uint32_t const generation = ++ m_nodeGeneration[node];
+        m_wheel.schedule(time, {node, value, generation});
+        m_nodeProjected[node] = value;
+    }
+};
+
+/**
+ * @brief Update Combinational Logic Gates and schedule node changes after each gate's delay
+ *
+ * Same as update_combinational, but outputs are compared against projected values, so a change
+ * is only scheduled once even if the gate is updated again before the change happens. If the
+ * output returns to its current value before a pending change happens, the change is cancelled.
+ *
+ * @return true if any node changes are scheduled
+ */
+template <typename RANGE_T>
+bool update_combinational_timed(
+        RANGE_T&&                           toUpdate,
+        lgrn::KeyedVec<ElemLocalId, ElementId> const &localToElem,
+        Nodes::Connections_t          const &elemConnect,
+        lgrn::KeyedVec<NodeId, ELogic> const &nodeValues,
+        CombinationalGates            const &gates,
+        UpdateTimed                         &rUpdTimed)
+{
+    auto const is_logic_high = [&nodeValues] (NodeId in) noexcept -> bool
+    {
+        return nodeValues[in] == ELogic::High;
+    };
+
+    bool scheduled = false;
+    SimTime_t const now = rUpdTimed.m_wheel.now();
+
+    for (ElemLocalId local : toUpdate)
+    {
+        ElementId const elem    = localToElem[local];
+        auto connectedNodes     = elemConnect[elem];
+
+        ELogic const outLogic = eval_gate(gates.m_localGates[local],
+                                          connectedNodes.begin() + 1, connectedNodes.end(), is_logic_high);
+
+        NodeId const out = *connectedNodes.begin();
+        if (rUpdTimed.m_nodeProjected[out] != outLogic)
+        {
+            CombinationalGates::GateDelay const delay = gates.m_localDelays[local];
+            rUpdTimed.assign(now + (outLogic == ELogic::High ? delay.m_rise : delay.m_fall), out, outLogic);
+            scheduled = true;
+        }
+    }
+
+    return scheduled;
+}
+
+/**
+ * @brief Advance to the next scheduled time and write its events into UpdateNodes
+ *
+ * Cancelled events, and events that don't change a node's current value are skipped. Apply with
+ * update_nodes afterwards.
+ *
+ * @param limit [in] Don't go past this time
+ *
+ * @return false if there are no more events up to limit
+ */
+inline bool take_timed_events(
+        SimTime_t                               limit,
+        lgrn::KeyedVec<NodeId, ELogic>  const   &nodeValues,
+        UpdateTimed                             &rUpdTimed,
+        UpdateNodes<ELogic>                     &rUpdNodes)
+{
+    rUpdTimed.m_current.clear();
+    if ( ! rUpdTimed.m_wheel.advance(limit, rUpdTimed.m_current) )
+    {
+        return false;
+    }
+
+    for (NodeEvent const &event : rUpdTimed.m_current)
+    {
+        if (event.m_generation != rUpdTimed.m_nodeGeneration[event.m_node])
+        {
+            continue; // Superseded by a newer event
+        }
+
+        rUpdNodes.m_nodeNewValues[event.m_node] = event.m_value;
+        if (nodeValues[event.m_node] != event.m_value)
+        {
+            rUpdNodes.m_nodeDirty.insert(event.m_node);
+        }
+        else
+        {
+            rUpdNodes.m_nodeDirty.erase(event.m_node);
+        }
+    }
+    return true;
+}
+
+constexpr auto const gc_elemGate         = ElemTypeId(0);
+constexpr auto const gc_elemFlipFlop     = ElemTypeId(1);
+constexpr auto const gc_elemWordOp       = ElemTypeId(2);
+constexpr auto const gc_elemBitSelect    = ElemTypeId(3);
+constexpr auto const gc_elemBitMerge     = ElemTypeId(4);
+constexpr auto const gc_elemMemoryRead   = ElemTypeId(5);
+constexpr auto const gc_elemMemoryWrite  = ElemTypeId(6);
+
+constexpr std::size_t const gc_elemTypeCount = 7;
 
 } // namespace circuits
@@ -41,6 +41,20 @@ struct UserCircuit
         m_logicNodes.m_elemConnect      .data_reserve(maxNodes);
         m_logicValues.m_nodeValues      .resize(maxNodes);
         m_gates.m_localGates            .reserve(maxElem);
+        m_gates.m_localDelays           .resize(maxElem);
+        m_flipFlops.m_localDomain       .resize(maxElem, id_null<ClockDomainId>());
+        m_flipFlops.m_clockToDomain     .resize(maxNodes, id_null<ClockDomainId>());
+        m_wordNodes.m_nodeIds           .reserve(maxNodes);
+        m_wordNodes.m_nodePublisher     .resize(maxNodes, id_null<ElementId>());
+        m_wordNodes.m_nodeSubscribers   .ids_reserve(maxNodes);
+        m_wordNodes.m_nodeSubscribers   .data_reserve(maxElem);
+        m_wordNodes.m_elemConnect       .ids_reserve(maxElem);
+        m_wordNodes.m_elemConnect       .data_reserve(maxNodes);
+        m_wordValues.m_nodeValues       .resize(maxNodes);
+        m_wordOps.m_localOps            .resize(maxElem);
+        m_wordBits.m_selectBit          .resize(maxElem);
+        m_memories.m_readToBlock        .resize(maxElem);
+        m_memories.m_writePorts         .resize(maxElem);
 
         m_elements.m_perType            .resize(maxTypes);
         for (PerElemType &rPerType : m_elements.m_perType)
@@ -54,23 +68,37 @@ struct UserCircuit
     {
         t_wipElements                   = &m_elements;
         t_wipGates                      = &m_gates;
+        t_wipFlipFlops                  = &m_flipFlops;
+        t_wipWordOps                    = &m_wordOps;
+        t_wipWordBits                   = &m_wordBits;
+        t_wipMemories                   = &m_memories;
         WipNodes<ELogic>::smt_pNodes    = &m_logicNodes;
+        WipNodes<std::uint64_t>::smt_pNodes = &m_wordNodes;
     }
 
     void build_end()
     {
         t_wipElements                   = nullptr;
         t_wipGates                      = nullptr;
+        t_wipFlipFlops                  = nullptr;
+        t_wipWordOps                    = nullptr;
+        t_wipWordBits                   = nullptr;
+        t_wipMemories                   = nullptr;
         WipNodes<ELogic>::smt_pNodes    = nullptr;
+        WipNodes<std::uint64_t>::smt_pNodes = nullptr;
 
         populate_pub_sub(m_elements, m_logicNodes);
+        populate_pub_sub(m_elements, m_wordNodes);
     }
 
     UpdateElemTypes_t setup_element_updater()
     {
         UpdateElemTypes_t out;
         out.resize(m_maxTypes);
-        out[gc_elemGate].m_localDirty.resize(m_elements.m_perType[gc_elemGate].m_localIds.capacity());
+        for (std::size_t type = 0; type < m_maxTypes; ++type)
+        {
+            out[ElemTypeId(type)].m_localDirty.resize(m_elements.m_perType[ElemTypeId(type)].m_localIds.capacity());
+        }
 
         // Initially set all to dirty get to valid state
         // middle parts of a circuit may be unresponsive otherwise
@@ -93,11 +121,74 @@ struct UserCircuit
         return out;
     }
 
+    UpdateNodes<std::uint64_t> setup_word_updater()
+    {
+        UpdateNodes<std::uint64_t> out;
+        out.m_nodeDirty.resize(m_maxNodes);
+        out.m_nodeNewValues.resize(m_maxNodes);
+
+        return out;
+    }
+
+    UpdateTimed setup_timed_updater()
+    {
+        UpdateTimed out;
+        out.m_nodeProjected = m_logicValues.m_nodeValues;
+        out.m_nodeGeneration.resize(m_maxNodes, 0);
+
+        return out;
+    }
+
+    /**
+     * @brief Total memory used by all containers, to help right-size the max counts passed to
+     *        the constructor
+     */
+    lgrn::MemoryStats memory_stats() const
+    {
+        lgrn::MemoryStats out = lgrn::sum_memory_stats(
+                m_elements.m_ids, m_elements.m_elemTypes, m_elements.m_elemToLocal,
+                m_elements.m_perType,
+                m_logicNodes.m_nodeIds, m_logicNodes.m_nodeSubscribers,
+                m_logicNodes.m_nodePublisher, m_logicNodes.m_elemConnect,
+                m_logicValues.m_nodeValues,
+                m_gates.m_localGates, m_gates.m_localDelays,
+                m_flipFlops.m_localDomain, m_flipFlops.m_domains, m_flipFlops.m_clockToDomain,
+                m_flipFlops.m_domainsTouched,
+                m_wordNodes.m_nodeIds, m_wordNodes.m_nodeSubscribers,
+                m_wordNodes.m_nodePublisher, m_wordNodes.m_elemConnect,
+                m_wordValues.m_nodeValues,
+                m_wordOps.m_localOps, m_wordBits.m_selectBit,
+                m_memories.m_blocks, m_memories.m_readToBlock, m_memories.m_writePorts);
+
+        for (ClockDomain const &rDomain : m_flipFlops.m_domains)
+        {
+            out += lgrn::sum_memory_stats(rDomain.m_inD, rDomain.m_outQ, rDomain.m_state);
+        }
+
+        for (Memories::Block const &rBlock : m_memories.m_blocks)
+        {
+            out += lgrn::sum_memory_stats(rBlock.m_words, rBlock.m_readPorts);
+        }
+
+        for (PerElemType const &rPerType : m_elements.m_perType)
+        {
+            out += lgrn::sum_memory_stats(rPerType.m_localIds, rPerType.m_localToElem);
+        }
+        return out;
+    }
+
     // Forget inheritance ever existed
     Elements            m_elements;
     Nodes               m_logicNodes;
     NodeValues<ELogic>  m_logicValues;
     CombinationalGates  m_gates;
+    FlipFlops           m_flipFlops;
+
+    Nodes                       m_wordNodes;
+    NodeValues<std::uint64_t>   m_wordValues;
+    WordOps                     m_wordOps;
+    WordBits                    m_wordBits;
+    Memories                    m_memories;
 
     std::size_t m_maxElem{0};
     std::size_t m_maxNodes{0};
@@ -115,6 +206,87 @@ constexpr bool is_high(ELogic in)
     return in == ELogic::High;
 }
 
+/**
+ * @brief Update dirty logic gates and flip-flops
+ *
+ * @return true if any node changes are written
+ */
+static bool update_logic_elements(
+        UserCircuit& rCircuit,
+        UpdateNodes<ELogic>& rUpdLogic,
+        UpdateElemTypes_t& rUpdElems)
+{
+    bool nodeUpdated = update_combinational(
+            rUpdElems[gc_elemGate].m_localDirty,
+            rCircuit.m_elements.m_perType[gc_elemGate].m_localToElem,
+            rCircuit.m_logicNodes.m_elemConnect,
+            rCircuit.m_logicValues.m_nodeValues,
+            rCircuit.m_gates,
+            rUpdLogic);
+    rUpdElems[gc_elemGate].m_localDirty.clear();
+
+    nodeUpdated |= update_flip_flops(
+            rUpdElems[gc_elemFlipFlop].m_localDirty,
+            rCircuit.m_logicValues.m_nodeValues,
+            rCircuit.m_flipFlops,
+            rUpdLogic);
+    rUpdElems[gc_elemFlipFlop].m_localDirty.clear();
+
+    return nodeUpdated;
+}
+
+/**
+ * @brief Update dirty word-level elements: word ops, bit select/merge, and memory ports
+ *
+ * @return true if any node changes are written, or memory read ports need updating
+ */
+static bool update_word_elements(
+        UserCircuit& rCircuit,
+        UpdateNodes<ELogic>& rUpdLogic,
+        UpdateNodes<std::uint64_t>& rUpdWords,
+        UpdateElemTypes_t& rUpdElems)
+{
+    auto const& perType = rCircuit.m_elements.m_perType;
+    auto const& logicConnect = rCircuit.m_logicNodes.m_elemConnect;
+    auto const& wordConnect  = rCircuit.m_wordNodes.m_elemConnect;
+    auto const& logicValues  = rCircuit.m_logicValues.m_nodeValues;
+    auto const& wordValues   = rCircuit.m_wordValues.m_nodeValues;
+
+    bool nodeUpdated = update_word_ops(
+            rUpdElems[gc_elemWordOp].m_localDirty,
+            perType[gc_elemWordOp].m_localToElem,
+            wordConnect, wordValues, rCircuit.m_wordOps, rUpdWords);
+    rUpdElems[gc_elemWordOp].m_localDirty.clear();
+
+    nodeUpdated |= update_bit_select(
+            rUpdElems[gc_elemBitSelect].m_localDirty,
+            perType[gc_elemBitSelect].m_localToElem,
+            wordConnect, logicConnect, wordValues, logicValues, rCircuit.m_wordBits, rUpdLogic);
+    rUpdElems[gc_elemBitSelect].m_localDirty.clear();
+
+    nodeUpdated |= update_bit_merge(
+            rUpdElems[gc_elemBitMerge].m_localDirty,
+            perType[gc_elemBitMerge].m_localToElem,
+            wordConnect, logicConnect, wordValues, logicValues, rUpdWords);
+    rUpdElems[gc_elemBitMerge].m_localDirty.clear();
+
+    nodeUpdated |= update_memory_read(
+            rUpdElems[gc_elemMemoryRead].m_localDirty,
+            perType[gc_elemMemoryRead].m_localToElem,
+            wordConnect, wordValues, rCircuit.m_memories, rUpdWords);
+    rUpdElems[gc_elemMemoryRead].m_localDirty.clear();
+
+    // Written blocks mark read ports dirty for the next step
+    nodeUpdated |= update_memory_write(
+            rUpdElems[gc_elemMemoryWrite].m_localDirty,
+            perType[gc_elemMemoryWrite].m_localToElem,
+            wordConnect, logicConnect, wordValues, logicValues,
+            rCircuit.m_memories, rUpdElems[gc_elemMemoryRead]);
+    rUpdElems[gc_elemMemoryWrite].m_localDirty.clear();
+
+    return nodeUpdated;
+}
+
 /**
  * @brief Step a circuit through time, stop when no more things change
  *
@@ -138,19 +310,90 @@ static int step_until_stable(
                 rUpdElems);
         rUpdLogic.m_nodeDirty.clear();
 
-        elemNotified = update_combinational(
+        elemNotified = update_logic_elements(rCircuit, rUpdLogic, rUpdElems);
+
+        steps ++;
+    }
+
+    return steps;
+}
+
+/**
+ * @brief Same as step_until_stable, but also updates word nodes and word-level elements
+ */
+static int step_rtl_until_stable(
+        UserCircuit& rCircuit,
+        UpdateNodes<ELogic>& rUpdLogic,
+        UpdateNodes<std::uint64_t>& rUpdWords,
+        UpdateElemTypes_t& rUpdElems,
+        int maxSteps)
+{
+    int steps = 0;
+    bool elemNotified = true;
+    while (elemNotified && steps < maxSteps)
+    {
+        update_nodes(
+                rUpdLogic.m_nodeDirty,
+                rCircuit.m_logicNodes.m_nodeSubscribers,
+                rUpdLogic.m_nodeNewValues,
+                rCircuit.m_logicValues.m_nodeValues,
+                rUpdElems);
+        rUpdLogic.m_nodeDirty.clear();
+
+        update_nodes(
+                rUpdWords.m_nodeDirty,
+                rCircuit.m_wordNodes.m_nodeSubscribers,
+                rUpdWords.m_nodeNewValues,
+                rCircuit.m_wordValues.m_nodeValues,
+                rUpdElems);
+        rUpdWords.m_nodeDirty.clear();
+
+        elemNotified = update_logic_elements(rCircuit, rUpdLogic, rUpdElems);
+        elemNotified |= update_word_elements(rCircuit, rUpdLogic, rUpdWords, rUpdElems);
+
+        steps ++;
+    }
+
+    return steps;
+}
+
+/**
+ * @brief Run a circuit with per-gate delays until a certain time
+ *
+ * Each loop applies only the node changes scheduled for the next time that has any, then updates
+ * elements that were affected.
+ */
+static void step_timed_until(
+        UserCircuit& rCircuit,
+        UpdateTimed& rUpdTimed,
+        UpdateNodes<ELogic>& rUpdLogic,
+        UpdateElemTypes_t& rUpdElems,
+        SimTime_t limit)
+{
+    while (true)
+    {
+        update_combinational_timed(
                 rUpdElems[gc_elemGate].m_localDirty,
                 rCircuit.m_elements.m_perType[gc_elemGate].m_localToElem,
                 rCircuit.m_logicNodes.m_elemConnect,
                 rCircuit.m_logicValues.m_nodeValues,
                 rCircuit.m_gates,
-                rUpdLogic);
+                rUpdTimed);
         rUpdElems[gc_elemGate].m_localDirty.clear();
 
-        steps ++;
-    }
+        if ( ! take_timed_events(limit, rCircuit.m_logicValues.m_nodeValues, rUpdTimed, rUpdLogic) )
+        {
+            break;
+        }
 
-    return steps;
+        update_nodes(
+                rUpdLogic.m_nodeDirty,
+                rCircuit.m_logicNodes.m_nodeSubscribers,
+                rUpdLogic.m_nodeNewValues,
+                rCircuit.m_logicValues.m_nodeValues,
+                rUpdElems);
+        rUpdLogic.m_nodeDirty.clear();
+    }
 }
 
 /**
@@ -334,6 +577,10 @@ static void test_xor_nand()
     updLogic.assign(B, ELogic::High);
     step_until_stable(circuit, updLogic, updElems, 99);
     std::cout << "* 1 XOR 1 = " << is_high(outVal) << "\n";
+
+    lgrn::MemoryStats const stats = circuit.memory_stats();
+    std::cout << "* memory: " << stats.m_bytesUsed << " / " << stats.m_bytesReserved << " bytes used, "
+              << stats.m_holeCount << " holes\n";
 }
 
 /**
@@ -426,12 +673,240 @@ static void test_edge_detect()
     }, {Q}, circuit, updLogic, updElems, 2);
 }
 
+/**
+ * @brief Same as stupid_scope, but with timed simulation where each character is 1 tick
+ */
+static void stupid_scope_timed(
+        std::initializer_list<Waveform> inWaves,
+        std::initializer_list<NodeId> out,
+        UserCircuit& rCircuit,
+        UpdateTimed& rUpdTimed,
+        UpdateNodes<ELogic>& rUpdLogic,
+        UpdateElemTypes_t& rUpdElems)
+{
+    std::size_t minSize = inWaves.begin()->m_wave.size();
+    for (Waveform wave : inWaves)
+    {
+        minSize = std::min(minSize, wave.m_wave.size());
+    }
+
+    std::vector<std::string> outWaveforms(out.size(), std::string(minSize, '_'));
+
+    for (SimTime_t time = 0; time < minSize; ++time)
+    {
+        for (Waveform wave : inWaves)
+        {
+            rUpdTimed.assign(time, wave.m_node, (wave.m_wave[time] == '#') ? ELogic::High : ELogic::Low);
+        }
+
+        step_timed_until(rCircuit, rUpdTimed, rUpdLogic, rUpdElems, time);
+
+        for (unsigned int j = 0; j < out.size(); ++j)
+        {
+            outWaveforms[j][time] = is_high(rCircuit.m_logicValues.m_nodeValues[*(out.begin() + j)]) ? '#' : '_';
+        }
+    }
+
+    for (unsigned int i = 0; i < inWaves.size(); ++i)
+    {
+        char letter = 'A' + i;
+        std::cout << " In[" << letter << "]: " << (inWaves.begin() + i)->m_wave << "\n";
+    }
+
+    for (unsigned int i = 0; i < out.size(); ++i)
+    {
+        char letter = 'A' + i;
+        std::cout << "Out[" << letter << "]: " << outWaveforms[i] << "\n";
+    }
+}
+
+/**
+ * @brief Test Edge detector with timed simulation, where pulse width depends on the inverter delay
+ */
+static void test_edge_detect_timed()
+{
+    UserCircuit circuit(64, 64, 2);
+
+    circuit.build_begin();
+
+    auto const [A, Dl, Q] = create_nodes<3, ELogic>();
+
+    ElementId const inverter = gate_NAND({A}, Dl);
+    gate_AND({A, Dl}, Q);
+
+    // Slow inverter, 3 ticks
+    gate_delay(inverter, 3, 3);
+
+    circuit.build_end();
+
+    UpdateElemTypes_t   updElems = circuit.setup_element_updater();
+    UpdateNodes<ELogic> updLogic = circuit.setup_logic_updater();
+    UpdateTimed         updTimed = circuit.setup_timed_updater();
+
+    std::cout << "Edge Detector (timed, 3 tick inverter):\n";
+
+    stupid_scope_timed({
+        {A, "____####_____##______#######_____"},
+    }, {Q}, circuit, updTimed, updLogic, updElems);
+}
+
+/**
+ * @brief Test 4-bit synchronous counter made of a register and gates
+ */
+static void test_counter()
+{
+    UserCircuit circuit(64, 64, 2);
+
+    circuit.build_begin();
+
+    auto const [clk, Q0, Q1, Q2, Q3, D0, D1, D2, D3, C01, C012] = create_nodes<11, ELogic>();
+
+    // Each bit toggles when all lower bits are 1
+    gate_NAND({Q0}, D0);
+    gate_XOR({Q1, Q0}, D1);
+    gate_AND({Q0, Q1}, C01);
+    gate_XOR({Q2, C01}, D2);
+    gate_AND({Q0, Q1, Q2}, C012);
+    gate_XOR({Q3, C012}, D3);
+
+    register_D(clk, {D0, D1, D2, D3}, {Q0, Q1, Q2, Q3});
+
+    circuit.build_end();
+
+    UpdateElemTypes_t   updElems = circuit.setup_element_updater();
+    UpdateNodes<ELogic> updLogic = circuit.setup_logic_updater();
+
+    auto const& values = circuit.m_logicValues.m_nodeValues;
+
+    std::cout << "4-bit counter with D Flip-flops:\n*";
+
+    step_until_stable(circuit, updLogic, updElems, 99);
+
+    for (int cycle = 0; cycle < 20; ++cycle)
+    {
+        updLogic.assign(clk, ELogic::High);
+        step_until_stable(circuit, updLogic, updElems, 99);
+        updLogic.assign(clk, ELogic::Low);
+        step_until_stable(circuit, updLogic, updElems, 99);
+
+        int const count = is_high(values[Q0]) | (is_high(values[Q1]) << 1)
+                        | (is_high(values[Q2]) << 2) | (is_high(values[Q3]) << 3);
+        std::cout << " " << count;
+    }
+    std::cout << "\n";
+}
+
+/**
+ * @brief Test word-level datapath that sums the contents of a ROM
+ *
+ * Registers are single-word memory blocks. A handful of word elements replace what would be
+ * hundreds of gates and flip-flops.
+ */
+static void test_rtl_accumulator()
+{
+    UserCircuit circuit(64, 64, gc_elemTypeCount);
+
+    circuit.build_begin();
+
+    auto const [clk, writeEn, stepA, stepB, big] = create_nodes<5, ELogic>();
+    auto const [pc, pcNext, step, instr, acc, accNext, zero, limit, isBig]
+            = create_nodes<9, std::uint64_t>();
+
+    MemoryId const rom   = memory_block({3, 1, 4, 1, 5, 9, 2, 6});
+    MemoryId const pcReg = memory_block({0});
+    MemoryId const acReg = memory_block({0});
+
+    // PC increments by 'step' from 2 logic inputs, and wraps around 8 instructions
+    bit_merge({stepA, stepB}, step);
+    word_ADD(pc, step, pcNext, 3);
+    memory_read(pcReg, zero, pc);
+    memory_write(pcReg, clk, writeEn, zero, pcNext);
+
+    // Accumulate ROM contents
+    memory_read(rom, pc, instr);
+    word_ADD(acc, instr, accNext, 16);
+    memory_read(acReg, zero, acc);
+    memory_write(acReg, clk, writeEn, zero, accNext);
+
+    // Logic output when accumulator exceeds limit
+    word_LT(limit, acc, isBig);
+    bit_select(isBig, 0, big);
+
+    circuit.build_end();
+
+    UpdateElemTypes_t           updElems = circuit.setup_element_updater();
+    UpdateNodes<ELogic>         updLogic = circuit.setup_logic_updater();
+    UpdateNodes<std::uint64_t>  updWords = circuit.setup_word_updater();
+
+    auto const& logicValues = circuit.m_logicValues.m_nodeValues;
+    auto const& wordValues  = circuit.m_wordValues.m_nodeValues;
+
+    updLogic.assign(writeEn, ELogic::High);
+    updLogic.assign(stepA,   ELogic::High);
+    updLogic.assign(stepB,   ELogic::Low);
+    updWords.assign(limit,   20);
+    step_rtl_until_stable(circuit, updLogic, updWords, updElems, 99);
+
+    std::cout << "Word-level ROM accumulator:\n";
+
+    for (int cycle = 0; cycle < 8; ++cycle)
+    {
+        std::cout << "* pc=" << wordValues[pc] << " instr=" << wordValues[instr]
+                  << " acc=" << wordValues[acc] << " acc>20=" << is_high(logicValues[big]) << "\n";
+
+        updLogic.assign(clk, ELogic::High);
+        step_rtl_until_stable(circuit, updLogic, updWords, updElems, 99);
+        updLogic.assign(clk, ELogic::Low);
+        step_rtl_until_stable(circuit, updLogic, updWords, updElems, 99);
+    }
+
+    std::cout << "* final acc=" << wordValues[acc] << ", " << circuit.m_elements.m_ids.size()
+              << " elements\n";
+}
+
+/**
+ * @brief Test timed simulation with unequal rise and fall delays
+ *
+ * Pulses shorter than the rise delay are filtered out, and longer pulses come out shortened by
+ * the difference between rise and fall delays.
+ */
+static void test_asymmetric_delay_timed()
+{
+    UserCircuit circuit(64, 64, 2);
+
+    circuit.build_begin();
+
+    auto const [A, B, Q] = create_nodes<3, ELogic>();
+
+    ElementId const gate = gate_AND({A, B}, Q);
+
+    // Slow to rise, fast to fall
+    gate_delay(gate, 5, 1);
+
+    circuit.build_end();
+
+    UpdateElemTypes_t   updElems = circuit.setup_element_updater();
+    UpdateNodes<ELogic> updLogic = circuit.setup_logic_updater();
+    UpdateTimed         updTimed = circuit.setup_timed_updater();
+
+    std::cout << "AND gate (timed, rise 5, fall 1):\n";
+
+    stupid_scope_timed({
+        {A, "##____###_____#########______###"},
+        {B, "################################"},
+    }, {Q}, circuit, updTimed, updLogic, updElems);
+}
+
 int main(int argc, char** argv)
 {
     test_manual_build();
     test_xor_nand();
     test_sr_latch();
     test_edge_detect();
+    test_edge_detect_timed();
+    test_asymmetric_delay_timed();
+    test_counter();
+    test_rtl_accumulator();
 
     return 0;
 }
@@ -0,0 +1,201 @@
+/**
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: 2026 Neal Nicdao <chrisnicdao0@gmail.com>
+ */
+#pragma once
+
+#include <longeron/utility/asserts.hpp>
+#include <longeron/utility/bitmath.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace circuits
+{
+
+using SimTime_t = std::uint64_t;
+
+/**
+ * @brief Hierarchical timing wheel, schedules events to be processed at a future simulation time
+ *
+ * Level 0 has 64 slots of 1 tick each, level 1 has 64 slots of 64 ticks each, and so on. An event
+ * is placed on the lowest level where its time shares all higher digits (base 64) with the
+ * current time. Each level has a 64-bit mask of which slots are occupied, so finding the next
+ * event is a ctz instead of searching a heap.
+ *
+ * When lower levels run out of events, the next occupied slot of a higher level is cascaded down:
+ * time jumps to the start of that slot, and its events are redistributed into lower levels.
+ * Events too far ahead for all levels wait in an overflow list.
+ */
+template<typename EVENT_T>
+class TimingWheel
+{
+    static constexpr unsigned int smc_levels    = 4;
+    static constexpr unsigned int smc_slotBits  = 6;
+    static constexpr unsigned int smc_slots     = 1u << smc_slotBits;
+
+    struct Timed
+    {
+        SimTime_t   m_time;
+        EVENT_T     m_event;
+    };
+
+public:
+
+    SimTime_t now() const noexcept { return m_now; }
+
+    bool empty() const noexcept { return m_count == 0; }
+
+    std::size_t size() const noexcept { return m_count; }
+
+    /**
+     * @brief Schedule an event. Time must not be in the past.
+     */
+    void schedule(SimTime_t time, EVENT_T const& event)
+    {
+        LGRN_ASSERTMV(time >= m_now, "Can't schedule events in the past", time, m_now);
+        place({time, event});
+        ++ m_count;
+    }
+
+    /**
+     * @brief Move time forward to the next scheduled events, and take all events at that time
+     *
+     * @param limit [in] Don't go past this time
+     * @param rOut  [out] Events are appended to this
+     *
+     * @return true if events were taken, false if there are no events up to limit
+     */
+    bool advance(SimTime_t limit, std::vector<EVENT_T>& rOut)
+    {
+        while (true)
+        {
+            // Level 0, slots at or after the current time
+            std::uint64_t const current = m_occupied[0] & (~std::uint64_t(0) << slot_of(m_now, 0));
+            if (current != 0)
+            {
+                unsigned int const slot = lgrn::ctz(current);
+                SimTime_t const time = (m_now & ~SimTime_t(smc_slots - 1)) | slot;
+                if (time > limit)
+                {
+                    return false;
+                }
+
+                m_now = time;
+                std::vector<Timed> &rSlot = m_wheel[0][slot];
+                for (Timed const &timed : rSlot)
+                {
+                    rOut.push_back(timed.m_event);
+                }
+                m_count -= rSlot.size();
+                rSlot.clear();
+                m_occupied[0] &= ~(std::uint64_t(1) << slot);
+                return true;
+            }
+
+            if ( ! cascade(limit) )
+            {
+                return false;
+            }
+        }
+    }
+
+private:
+
+    static unsigned int slot_of(SimTime_t time, unsigned int level) noexcept
+    {
+        return unsigned((time >> (level * smc_slotBits)) & (smc_slots - 1));
+    }
+
+    void place(Timed const& timed)
+    {
+        // Highest base-64 digit that differs from the current time
+        SimTime_t const diff = timed.m_time ^ m_now;
+        unsigned int level = 0;
+        while (level < smc_levels && (diff >> ((level + 1) * smc_slotBits)) != 0)
+        {
+            ++ level;
+        }
+
+        if (level == smc_levels)
+        {
+            m_overflow.push_back(timed);
+            return;
+        }
+
+        unsigned int const slot = slot_of(timed.m_time, level);
+        m_wheel[level][slot].push_back(timed);
+        m_occupied[level] |= std::uint64_t(1) << slot;
+    }
+
+    /**
+     * @brief Jump to the next occupied slot of higher levels, and redistribute its events
+     *
+     * @return false if there is nothing to cascade up to limit
+     */
+    bool cascade(SimTime_t limit)
+    {
+        for (unsigned int level = 1; level < smc_levels; ++level)
+        {
+            // Slots at the current digit are always empty, they were cascaded to get there
+            unsigned int const currentSlot = slot_of(m_now, level);
+            std::uint64_t const ahead = (currentSlot == smc_slots - 1)
+                                      ? 0 : m_occupied[level] & (~std::uint64_t(0) << (currentSlot + 1));
+            if (ahead == 0)
+            {
+                continue;
+            }
+
+            unsigned int const slot  = lgrn::ctz(ahead);
+            unsigned int const shift = level * smc_slotBits;
+            SimTime_t const start = ((m_now >> (shift + smc_slotBits)) << (shift + smc_slotBits))
+                                  | (SimTime_t(slot) << shift);
+            if (start > limit)
+            {
+                return false;
+            }
+
+            m_now = start;
+            m_occupied[level] &= ~(std::uint64_t(1) << slot);
+            std::vector<Timed> events = std::move(m_wheel[level][slot]);
+            m_wheel[level][slot].clear();
+            for (Timed const &timed : events)
+            {
+                place(timed);
+            }
+            return true;
+        }
+
+        if (m_overflow.empty())
+        {
+            return false;
+        }
+
+        auto const earliest = std::min_element(m_overflow.begin(), m_overflow.end(),
+                [] (Timed const& lhs, Timed const& rhs) { return lhs.m_time < rhs.m_time; });
+        if (earliest->m_time > limit)
+        {
+            return false;
+        }
+
+        m_now = earliest->m_time;
+        std::vector<Timed> events = std::move(m_overflow);
+        m_overflow.clear();
+        for (Timed const &timed : events)
+        {
+            place(timed);
+        }
+        return true;
+    }
+
+    std::array<std::array<std::vector<Timed>, smc_slots>, smc_levels>   m_wheel;
+    std::array<std::uint64_t, smc_levels>                               m_occupied{};
+    std::vector<Timed>                                                  m_overflow;
+
+    SimTime_t                                                           m_now{0};
+    std::size_t                                                         m_count{0};
+};
+
+} // namespace circuits
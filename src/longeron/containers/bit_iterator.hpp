@@ -7,6 +7,7 @@
 #include <iterator>
 
 #include "../utility/bitmath.hpp"
+#include "../utility/trace.hpp"
 
 namespace lgrn
 {
@@ -65,7 +66,7 @@ public:
 
     ~BitPosIterator() = default;
 
-    constexpr BitPosIterator& operator++() noexcept
+    LGRN_TRACE_CONSTEXPR BitPosIterator& operator++() noexcept
     {
         // Remove LSB
         m_block = m_block & (m_block - 1);
@@ -76,6 +77,7 @@ public:
             // Skip empty blocks (no ones or no zero bits)
             do
             {
+                LGRN_COUNTER("BitPosIterator words visited");
                 ++m_it;
                 m_distance += sizeof(int_t) * 8;
             }
@@ -0,0 +1,300 @@
+/**
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: 2026 Neal Nicdao <chrisnicdao0@gmail.com>
+ */
+#pragma once
+
+#include "bit_view.hpp"
+
+#include "../utility/asserts.hpp"
+#include "../utility/bitmath.hpp"
+#include "../utility/memory_stats.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace lgrn
+{
+
+/**
+ * @brief Transpose a 64x64 bit matrix in-place, where bit c of block[r] is row r, column c
+ *
+ * Swaps progressively smaller sub-blocks (32x32, 16x16, ... 1x1) using masks, operating on whole
+ * 64-bit words at a time. 6 passes of 32 word pairs, no per-bit loops.
+ */
+inline void transpose_64x64(std::uint64_t* pBlock) noexcept
+{
+    std::uint64_t mask = 0x00000000FFFFFFFFull;
+    for (unsigned int width = 32; width != 0; width >>= 1, mask ^= mask << width)
+    {
+        for (unsigned int k = 0; k < 64; k = ((k | width) + 1) & ~width)
+        {
+            std::uint64_t const swap = ((pBlock[k] >> width) ^ pBlock[k | width]) & mask;
+            pBlock[k]         ^= swap << width;
+            pBlock[k | width] ^= swap;
+        }
+    }
+}
+
+/**
+ * @brief Dense 2D matrix of bits, where each row is a bitset
+ *
+ * Intended for dense many-to-many relationships (eg: which entities see which), where operations
+ * on entire rows are done 64 columns at a time.
+ *
+ * Rows are padded to a multiple of 64 columns. Padding bits are always zero.
+ */
+class BitMatrix
+{
+public:
+
+    using Row_t         = BitView< IteratorPair<std::uint64_t*, std::uint64_t*> >;
+    using RowConst_t    = BitView< IteratorPair<std::uint64_t const*, std::uint64_t const*> >;
+
+    BitMatrix() = default;
+
+    BitMatrix(std::size_t rows, std::size_t cols)
+    {
+        resize(rows, cols);
+    }
+
+    /**
+     * @brief Resize and clear all bits
+     */
+    void resize(std::size_t rows, std::size_t cols)
+    {
+        m_rows      = rows;
+        m_cols      = cols;
+        m_rowWords  = div_ceil(cols, 64);
+        m_words.assign(m_rows * m_rowWords, 0);
+    }
+
+    std::size_t rows() const noexcept { return m_rows; }
+    std::size_t cols() const noexcept { return m_cols; }
+
+    /**
+     * @return Number of 64-bit words per row
+     */
+    std::size_t row_words() const noexcept { return m_rowWords; }
+
+    bool test(std::size_t row, std::size_t col) const noexcept
+    {
+        LGRN_ASSERTMV_CHEAP(row < m_rows && col < m_cols, "Out of range", row, col, m_rows, m_cols);
+        return bit_test(row_data(row)[col / 64], col % 64);
+    }
+
+    void set(std::size_t row, std::size_t col) noexcept
+    {
+        LGRN_ASSERTMV_CHEAP(row < m_rows && col < m_cols, "Out of range", row, col, m_rows, m_cols);
+        row_data(row)[col / 64] |= std::uint64_t(1) << (col % 64);
+    }
+
+    void reset(std::size_t row, std::size_t col) noexcept
+    {
+        LGRN_ASSERTMV_CHEAP(row < m_rows && col < m_cols, "Out of range", row, col, m_rows, m_cols);
+        row_data(row)[col / 64] &= ~(std::uint64_t(1) << (col % 64));
+    }
+
+    void clear() noexcept
+    {
+        std::fill(m_words.begin(), m_words.end(), 0);
+    }
+
+    std::uint64_t*       row_data(std::size_t row) noexcept       { return m_words.data() + row * m_rowWords; }
+    std::uint64_t const* row_data(std::size_t row) const noexcept { return m_words.data() + row * m_rowWords; }
+
+    /**
+     * @return BitView of a row. Don't set padding bits past cols().
+     */
+    Row_t row(std::size_t row) noexcept
+    {
+        LGRN_ASSERTMV_CHEAP(row < m_rows, "Out of range", row, m_rows);
+        return Row_t{{row_data(row), row_data(row) + m_rowWords}};
+    }
+
+    RowConst_t row(std::size_t row) const noexcept
+    {
+        LGRN_ASSERTMV_CHEAP(row < m_rows, "Out of range", row, m_rows);
+        return RowConst_t{{row_data(row), row_data(row) + m_rowWords}};
+    }
+
+    /**
+     * @brief dst |= src, for rows of this matrix
+     */
+    void row_or(std::size_t dst, std::size_t src) noexcept
+    {
+        row_or_mask(dst, row_data(src));
+    }
+
+    /**
+     * @brief dst |= mask, where mask has row_words() words
+     */
+    void row_or_mask(std::size_t dst, std::uint64_t const* pMask) noexcept
+    {
+        std::uint64_t *pDst = row_data(dst);
+        for (std::size_t i = 0; i < m_rowWords; ++i)
+        {
+            pDst[i] |= pMask[i];
+        }
+    }
+
+    /**
+     * @brief dst &= src, for rows of this matrix
+     */
+    void row_and(std::size_t dst, std::size_t src) noexcept
+    {
+        row_and_mask(dst, row_data(src));
+    }
+
+    /**
+     * @brief dst &= mask, where mask has row_words() words
+     */
+    void row_and_mask(std::size_t dst, std::uint64_t const* pMask) noexcept
+    {
+        std::uint64_t *pDst = row_data(dst);
+        for (std::size_t i = 0; i < m_rowWords; ++i)
+        {
+            pDst[i] &= pMask[i];
+        }
+    }
+
+    /**
+     * @return Number of set bits in a row
+     */
+    std::size_t row_count(std::size_t row) const noexcept
+    {
+        std::uint64_t const *pRow = row_data(row);
+        std::size_t total = 0;
+        for (std::size_t i = 0; i < m_rowWords; ++i)
+        {
+            total += popcount(pRow[i]);
+        }
+        return total;
+    }
+
+    /**
+     * @return true if a row shares any set bits with a mask of row_words() words
+     */
+    bool row_intersects(std::size_t row, std::uint64_t const* pMask) const noexcept
+    {
+        std::uint64_t const *pRow = row_data(row);
+        for (std::size_t i = 0; i < m_rowWords; ++i)
+        {
+            if ((pRow[i] & pMask[i]) != 0)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Call a function for each row that shares any set bits with a mask
+     *
+     * @param pMask [in] Mask of row_words() words, eg: row_data() of another row
+     * @param func  [in] Callable as void(std::size_t row)
+     */
+    template<typename FUNC_T>
+    void for_each_row_intersecting(std::uint64_t const* pMask, FUNC_T&& func) const
+    {
+        // Only check words where the mask has bits
+        std::vector<std::size_t> maskWords;
+        for (std::size_t i = 0; i < m_rowWords; ++i)
+        {
+            if (pMask[i] != 0)
+            {
+                maskWords.push_back(i);
+            }
+        }
+
+        for (std::size_t row = 0; row < m_rows; ++row)
+        {
+            std::uint64_t const *pRow = row_data(row);
+            for (std::size_t const i : maskWords)
+            {
+                if ((pRow[i] & pMask[i]) != 0)
+                {
+                    func(row);
+                    break;
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Write a column as a bitset of rows() bits. For many columns, use transposed().
+     *
+     * @param pOut [out] At least div_ceil(rows(), 64) words
+     */
+    void column(std::size_t col, std::uint64_t* pOut) const noexcept
+    {
+        LGRN_ASSERTMV_CHEAP(col < m_cols, "Out of range", col, m_cols);
+        std::size_t const word = col / 64;
+        std::size_t const bit  = col % 64;
+        for (std::size_t rowBlock = 0; rowBlock < div_ceil(m_rows, 64); ++rowBlock)
+        {
+            std::size_t const rowFirst = rowBlock * 64;
+            std::size_t const rowLast  = std::min(m_rows, rowFirst + 64);
+            std::uint64_t out = 0;
+            for (std::size_t row = rowFirst; row < rowLast; ++row)
+            {
+                out |= ((row_data(row)[word] >> bit) & 1u) << (row - rowFirst);
+            }
+            pOut[rowBlock] = out;
+        }
+    }
+
+    /**
+     * @return Transposed matrix, where columns become rows. Makes all columns available for
+     *         row operations.
+     */
+    BitMatrix transposed() const
+    {
+        BitMatrix out{m_cols, m_rows};
+
+        std::uint64_t block[64];
+        for (std::size_t rowBlock = 0; rowBlock < div_ceil(m_rows, 64); ++rowBlock)
+        {
+            std::size_t const rowFirst = rowBlock * 64;
+            std::size_t const rowCount = std::min<std::size_t>(64, m_rows - rowFirst);
+
+            for (std::size_t colWord = 0; colWord < m_rowWords; ++colWord)
+            {
+                // Gather a 64x64 block, zero-padding past the last row
+                for (std::size_t i = 0; i < 64; ++i)
+                {
+                    block[i] = (i < rowCount) ? row_data(rowFirst + i)[colWord] : 0;
+                }
+
+                transpose_64x64(block);
+
+                // Row i of the block is now column (colWord * 64 + i)
+                std::size_t const colFirst = colWord * 64;
+                std::size_t const colCount = std::min<std::size_t>(64, m_cols - colFirst);
+                for (std::size_t i = 0; i < colCount; ++i)
+                {
+                    out.row_data(colFirst + i)[rowBlock] = block[i];
+                }
+            }
+        }
+        return out;
+    }
+
+    MemoryStats memory_stats() const noexcept
+    {
+        MemoryStats out = vector_memory_stats(m_words);
+        count_word_occupancy<true>(out, m_words.data(), m_words.data() + m_words.size());
+        return out;
+    }
+
+private:
+
+    std::vector<std::uint64_t>  m_words;
+    std::size_t                 m_rows{0};
+    std::size_t                 m_cols{0};
+    std::size_t                 m_rowWords{0};
+
+}; // class BitMatrix
+
+} // namespace lgrn
@@ -85,7 +85,7 @@ public:
 template <typename RANGE_T>
 constexpr bool BitView<RANGE_T>::test(std::size_t bit) const noexcept
 {
-    LGRN_ASSERTMV(bit < size(), "Bit position out of range", bit, size());
+    LGRN_ASSERTMV_CHEAP(bit < size(), "Bit position out of range", bit, size());
 
     std::size_t const block    = bit / smc_bitSize;
     std::size_t const blockBit = bit % smc_bitSize;
@@ -96,7 +96,7 @@ constexpr bool BitView<RANGE_T>::test(std::size_t bit) const noexcept
 template <typename RANGE_T>
 constexpr void BitView<RANGE_T>::set(std::size_t bit) noexcept
 {
-    LGRN_ASSERTMV(bit < size(), "Bit position out of range", bit, size());
+    LGRN_ASSERTMV_CHEAP(bit < size(), "Bit position out of range", bit, size());
 
     std::size_t const block = bit / smc_bitSize;
     std::size_t const blockBit = bit % smc_bitSize;
@@ -113,7 +113,7 @@ constexpr void BitView<RANGE_T>::set() noexcept
 template <typename RANGE_T>
 constexpr void BitView<RANGE_T>::reset(std::size_t bit) noexcept
 {
-    LGRN_ASSERTMV(bit < size(), "Bit position out of range", bit, size());
+    LGRN_ASSERTMV_CHEAP(bit < size(), "Bit position out of range", bit, size());
 
     std::size_t const block = bit / smc_bitSize;
     std::size_t const blockBit = bit % smc_bitSize;
@@ -0,0 +1,141 @@
+/**
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: 2026 Neal Nicdao <chrisnicdao0@gmail.com>
+ */
+#pragma once
+
+#include "../id_management/id_set_stl.hpp"
+#include "../id_management/keyed_vec_stl.hpp"
+#include "../utility/asserts.hpp"
+#include "../utility/bitmath.hpp"
+#include "../utility/memory_stats.hpp"
+
+#include <array>
+#include <cstdint>
+#include <utility>
+
+namespace lgrn
+{
+
+/**
+ * @brief Copy entries of src to dst, only for IDs in a dirty set
+ */
+template<typename ID_T, typename DATA_T, typename ALLOC_T, typename DIRTY_ID_T>
+void copy_dirty(KeyedVec<ID_T, DATA_T, ALLOC_T> const& src, KeyedVec<ID_T, DATA_T, ALLOC_T>& rDst,
+                IdSetStl<DIRTY_ID_T> const& dirty)
+{
+    LGRN_ASSERTM(src.size() == rDst.size(), "Buffers must be the same size");
+    auto const &words = dirty.vec();
+    for (std::size_t i = 0; i < words.size(); ++i)
+    {
+        std::uint64_t bits = words[i];
+        while (bits != 0)
+        {
+            std::size_t const index = i * 64 + ctz(bits);
+            rDst.base()[index] = src.base()[index];
+            bits &= bits - 1;
+        }
+    }
+}
+
+/**
+ * @brief Copy 64-bit words of src to dst, only for words containing IDs in a dirty set
+ */
+template<typename ID_T, typename DIRTY_ID_T>
+void copy_dirty(IdSetStl<ID_T> const& src, IdSetStl<ID_T>& rDst, IdSetStl<DIRTY_ID_T> const& dirty)
+{
+    LGRN_ASSERTM(src.vec().size() == rDst.vec().size(), "Buffers must be the same size");
+    auto const &words = dirty.vec();
+    for (std::size_t i = 0; i < words.size(); ++i)
+    {
+        if (words[i] != 0)
+        {
+            rDst.vec()[i] = src.vec()[i];
+        }
+    }
+}
+
+/**
+ * @brief Two copies of a container, one for reading the current state (front) and one for writing
+ *        the next state (back)
+ *
+ * Readers and writers of a simulation step can then run without affecting each other. After a
+ * step, swap() makes the back the new front without copying anything.
+ *
+ * The new back still holds the state from before the step. If only some entries were written,
+ * sync_back() brings it up to date by copying only those entries. If every entry was written
+ * anyway (eg: dense simulations), this step can be skipped.
+ *
+ * Works with KeyedVec and IdSetStl. Other containers can be used with front/back/swap alone, or
+ * by adding a copy_dirty overload.
+ */
+template<typename CONTAINER_T>
+class DoubleBuffered
+{
+public:
+
+    DoubleBuffered() = default;
+
+    explicit DoubleBuffered(CONTAINER_T const& initial)
+     : m_buffers{initial, initial}
+    { }
+
+    CONTAINER_T&       front()       noexcept { return m_buffers[m_front]; }
+    CONTAINER_T const& front() const noexcept { return m_buffers[m_front]; }
+    CONTAINER_T&       back()        noexcept { return m_buffers[m_front ^ 1u]; }
+    CONTAINER_T const& back()  const noexcept { return m_buffers[m_front ^ 1u]; }
+
+    /**
+     * @brief Swap front and back, O(1)
+     *
+     * References to front() and back() obtained before this now refer to the opposite buffer.
+     */
+    void swap() noexcept
+    {
+        m_front ^= 1u;
+    }
+
+    /**
+     * @brief Copy dirty entries from front to back, making both buffers equal if everything that
+     *        was written is in the dirty set
+     */
+    template<typename DIRTY_ID_T>
+    void sync_back(IdSetStl<DIRTY_ID_T> const& dirty)
+    {
+        copy_dirty(front(), back(), dirty);
+    }
+
+    /**
+     * @brief Swap, then sync the new back with the entries that were written. Usual way to finish
+     *        a step.
+     */
+    template<typename DIRTY_ID_T>
+    void swap_and_sync(IdSetStl<DIRTY_ID_T> const& dirty)
+    {
+        swap();
+        sync_back(dirty);
+    }
+
+    /**
+     * @brief Call a function with each buffer, eg: to resize both
+     */
+    template<typename FUNC_T>
+    void for_both(FUNC_T&& func)
+    {
+        func(m_buffers[0]);
+        func(m_buffers[1]);
+    }
+
+    MemoryStats memory_stats() const noexcept
+    {
+        return sum_memory_stats(m_buffers[0], m_buffers[1]);
+    }
+
+private:
+
+    std::array<CONTAINER_T, 2>  m_buffers;
+    unsigned int                m_front{0};
+
+}; // class DoubleBuffered
+
+} // namespace lgrn
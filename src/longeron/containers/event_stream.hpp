@@ -0,0 +1,402 @@
+/**
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: 2026 Neal Nicdao <chrisnicdao0@gmail.com>
+ */
+#pragma once
+
+#include "intarray_multimap.hpp" // for Span
+
+#include "../utility/asserts.hpp"
+#include "../utility/memory_stats.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <deque>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace lgrn
+{
+
+/**
+ * @brief Append-only stream of events that can be written to by many threads at once
+ *
+ * Each writing thread gets its own Writer, which appends to its own list of fixed-size chunks.
+ * Appending never locks or moves existing events; a lock is only taken to get a new chunk once
+ * the current one is full, or to create or release a Writer.
+ *
+ * Events are read once writing is done, through view() that iterates all chunks of all writers
+ * without copying. Order is only preserved within each Writer.
+ *
+ * reset() clears all events but keeps chunks allocated, so a stream reused every frame stops
+ * allocating once it reaches its peak size.
+ *
+ * @tparam CHUNK_SIZE Number of events per chunk
+ */
+template<typename T, std::size_t CHUNK_SIZE = 1024>
+class EventStream
+{
+    static_assert(CHUNK_SIZE != 0);
+
+    struct Chunk
+    {
+        T*       data()       noexcept { return std::launder(reinterpret_cast<T*>(m_storage)); }
+        T const* data() const noexcept { return std::launder(reinterpret_cast<T const*>(m_storage)); }
+
+        std::size_t m_size{0};
+        alignas(T) std::byte m_storage[sizeof(T) * CHUNK_SIZE];
+    };
+
+    struct Lane
+    {
+        std::vector<Chunk*> m_chunks;
+    };
+
+public:
+
+    using Span_t = Span<T const>;
+
+    /**
+     * @brief Appends events to an EventStream. Only to be used by one thread at a time.
+     */
+    class Writer
+    {
+    public:
+
+        Writer() = default;
+        Writer(Writer const& copy) = delete;
+        Writer(Writer&& move) noexcept
+         : m_pStream  {std::exchange(move.m_pStream, nullptr)}
+         , m_pLane    {std::exchange(move.m_pLane, nullptr)}
+         , m_pCurrent {std::exchange(move.m_pCurrent, nullptr)}
+        { }
+
+        Writer& operator=(Writer const& copy) = delete;
+        Writer& operator=(Writer&& move) noexcept
+        {
+            release();
+            m_pStream  = std::exchange(move.m_pStream, nullptr);
+            m_pLane    = std::exchange(move.m_pLane, nullptr);
+            m_pCurrent = std::exchange(move.m_pCurrent, nullptr);
+            return *this;
+        }
+
+        ~Writer() { release(); }
+
+        template<typename ... ARGS_T>
+        T& emplace(ARGS_T&& ... args)
+        {
+            LGRN_ASSERTM(m_pStream != nullptr, "Writer is not attached to a stream");
+            if (m_pCurrent == nullptr || m_pCurrent->m_size == CHUNK_SIZE)
+            {
+                m_pCurrent = m_pStream->take_chunk(*m_pLane);
+            }
+            T *pOut = new (m_pCurrent->data() + m_pCurrent->m_size) T(std::forward<ARGS_T>(args)...);
+            ++ m_pCurrent->m_size;
+            return *pOut;
+        }
+
+        T& push(T const& value) { return emplace(value); }
+        T& push(T&& value)      { return emplace(std::move(value)); }
+
+    private:
+
+        Writer(EventStream *pStream, Lane *pLane) noexcept
+         : m_pStream{pStream}
+         , m_pLane{pLane}
+        { }
+
+        void release() noexcept
+        {
+            if (m_pStream != nullptr)
+            {
+                m_pStream->release_lane(*m_pLane);
+                m_pStream = nullptr;
+            }
+        }
+
+        EventStream *m_pStream{nullptr};
+        Lane        *m_pLane{nullptr};
+        Chunk       *m_pCurrent{nullptr};
+
+        friend class EventStream;
+    };
+
+    /**
+     * @brief Iterates all events of a View, chunk by chunk
+     */
+    class Iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using difference_type   = std::ptrdiff_t;
+        using value_type        = T;
+        using pointer           = T const*;
+        using reference         = T const&;
+
+        Iterator() = default;
+        Iterator(Span_t const* pSpan, Span_t const* pSpanLast) noexcept
+         : m_pSpan{pSpan}
+         , m_pSpanLast{pSpanLast}
+        {
+            skip_empty();
+        }
+
+        reference operator*()  const noexcept { return *m_pElem; }
+        pointer   operator->() const noexcept { return m_pElem; }
+
+        Iterator& operator++() noexcept
+        {
+            ++ m_pElem;
+            if (m_pElem == m_pSpan->data() + m_pSpan->size())
+            {
+                ++ m_pSpan;
+                skip_empty();
+            }
+            return *this;
+        }
+
+        Iterator operator++(int) noexcept
+        {
+            Iterator copy{*this};
+            ++(*this);
+            return copy;
+        }
+
+        // End iterator has a null m_pElem
+        friend bool operator==(Iterator const& lhs, Iterator const& rhs) noexcept { return lhs.m_pElem == rhs.m_pElem; }
+        friend bool operator!=(Iterator const& lhs, Iterator const& rhs) noexcept { return lhs.m_pElem != rhs.m_pElem; }
+
+    private:
+
+        void skip_empty() noexcept
+        {
+            while (m_pSpan != m_pSpanLast && m_pSpan->size() == 0)
+            {
+                ++ m_pSpan;
+            }
+            m_pElem = (m_pSpan != m_pSpanLast) ? m_pSpan->data() : nullptr;
+        }
+
+        Span_t const    *m_pSpan{nullptr};
+        Span_t const    *m_pSpanLast{nullptr};
+        T const         *m_pElem{nullptr};
+    };
+
+    /**
+     * @brief Read-only view of all events across all chunks. Invalidated by writes and reset().
+     */
+    class View
+    {
+    public:
+        Iterator begin() const noexcept { return {m_spans.data(), m_spans.data() + m_spans.size()}; }
+        Iterator end()   const noexcept { return {}; }
+
+        std::size_t size() const noexcept { return m_size; }
+        bool empty() const noexcept { return m_size == 0; }
+
+        /**
+         * @return Contiguous arrays of events, one per chunk. Useful for splitting work.
+         */
+        std::vector<Span_t> const& chunks() const noexcept { return m_spans; }
+
+    private:
+        std::vector<Span_t> m_spans;
+        std::size_t         m_size{0};
+
+        friend class EventStream;
+    };
+
+    EventStream() = default;
+    EventStream(EventStream const& copy) = delete;
+    EventStream(EventStream&& move) = delete;
+    EventStream& operator=(EventStream const& copy) = delete;
+    EventStream& operator=(EventStream&& move) = delete;
+
+    ~EventStream()
+    {
+        LGRN_ASSERTM(m_writerCount == 0, "Writers must not outlive their stream");
+        destroy_events();
+    }
+
+    static constexpr std::size_t chunk_size() noexcept { return CHUNK_SIZE; }
+
+    /**
+     * @brief Create a Writer for the calling thread. Thread-safe
+     */
+    Writer writer()
+    {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        Lane *pLane;
+        if (m_freeLanes.empty())
+        {
+            // Room for every lane to be freed, so release_lane never allocates
+            m_freeLanes.reserve(m_lanes.size() + 1);
+            pLane = &m_lanes.emplace_back();
+        }
+        else
+        {
+            pLane = m_freeLanes.back();
+            m_freeLanes.pop_back();
+        }
+        ++ m_writerCount;
+
+        // Continue filling the last chunk left by a previous Writer of this lane
+        Writer out{this, pLane};
+        out.m_pCurrent = pLane->m_chunks.empty() ? nullptr : pLane->m_chunks.back();
+        return out;
+    }
+
+    /**
+     * @brief Get a view of all events. Not thread-safe with writes.
+     */
+    View view() const
+    {
+        View out;
+        for (Lane const &rLane : m_lanes)
+        {
+            for (Chunk const *pChunk : rLane.m_chunks)
+            {
+                out.m_spans.emplace_back(pChunk->data(), pChunk->m_size);
+                out.m_size += pChunk->m_size;
+            }
+        }
+        return out;
+    }
+
+    /**
+     * @brief Call a function for each event, without creating a View. Not thread-safe with writes.
+     */
+    template<typename FUNC_T>
+    void for_each(FUNC_T&& func) const
+    {
+        for (Lane const &rLane : m_lanes)
+        {
+            for (Chunk const *pChunk : rLane.m_chunks)
+            {
+                T const *pData = pChunk->data();
+                for (std::size_t i = 0; i < pChunk->m_size; ++i)
+                {
+                    func(pData[i]);
+                }
+            }
+        }
+    }
+
+    /**
+     * @return Number of events, counted across all chunks. Not thread-safe with writes.
+     */
+    std::size_t size() const noexcept
+    {
+        std::size_t out = 0;
+        for (Lane const &rLane : m_lanes)
+        {
+            for (Chunk const *pChunk : rLane.m_chunks)
+            {
+                out += pChunk->m_size;
+            }
+        }
+        return out;
+    }
+
+    /**
+     * @brief Remove all events, keeping chunks for reuse. All Writers must be destroyed first.
+     *
+     * Never allocates, as m_spareChunks is reserved to fit all chunks when they're created.
+     */
+    void reset() noexcept
+    {
+        LGRN_ASSERTM(m_writerCount == 0, "Writers must be destroyed before reset");
+        destroy_events();
+        for (Lane &rLane : m_lanes)
+        {
+            m_spareChunks.insert(m_spareChunks.end(), rLane.m_chunks.begin(), rLane.m_chunks.end());
+            rLane.m_chunks.clear();
+        }
+    }
+
+    /**
+     * @brief Free chunks that are not in use
+     */
+    void shrink_to_fit()
+    {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        for (Chunk *pChunk : m_spareChunks)
+        {
+            auto const found = std::find_if(m_allChunks.begin(), m_allChunks.end(),
+                                            [pChunk] (auto const& pOwned) { return pOwned.get() == pChunk; });
+            std::swap(*found, m_allChunks.back());
+            m_allChunks.pop_back();
+        }
+        m_spareChunks.clear();
+    }
+
+    MemoryStats memory_stats() const noexcept
+    {
+        MemoryStats out;
+        out.m_bytesReserved = m_allChunks.size() * sizeof(Chunk);
+        out.m_bytesUsed     = size() * sizeof(T);
+        return out;
+    }
+
+private:
+
+    Chunk* take_chunk(Lane &rLane)
+    {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        Chunk *pChunk;
+        if (m_spareChunks.empty())
+        {
+            // Room for every chunk to be spare, so reset never allocates
+            m_spareChunks.reserve(m_allChunks.size() + 1);
+            pChunk = m_allChunks.emplace_back(std::make_unique<Chunk>()).get();
+        }
+        else
+        {
+            pChunk = m_spareChunks.back();
+            m_spareChunks.pop_back();
+        }
+        rLane.m_chunks.push_back(pChunk);
+        return pChunk;
+    }
+
+    void release_lane(Lane &rLane) noexcept
+    {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        m_freeLanes.push_back(&rLane);
+        -- m_writerCount;
+    }
+
+    void destroy_events() noexcept
+    {
+        for (Lane &rLane : m_lanes)
+        {
+            for (Chunk *pChunk : rLane.m_chunks)
+            {
+                if constexpr ( ! std::is_trivially_destructible_v<T> )
+                {
+                    std::destroy_n(pChunk->data(), pChunk->m_size);
+                }
+                pChunk->m_size = 0;
+            }
+        }
+    }
+
+    // Lanes hold chunks written by a single Writer. Deque so lanes don't move when adding more.
+    std::deque<Lane>                        m_lanes;
+    std::vector<Lane*>                      m_freeLanes;
+    std::size_t                             m_writerCount{0};
+
+    std::vector< std::unique_ptr<Chunk> >   m_allChunks;
+    std::vector<Chunk*>                     m_spareChunks;
+
+    std::mutex                              m_mutex;
+
+}; // class EventStream
+
+} // namespace lgrn
@@ -6,6 +6,7 @@
 
 #include "../utility/bitmath.hpp"
 #include "../utility/asserts.hpp"
+#include "../utility/memory_stats.hpp"
 
 #include <cstdint>
 #include <array>
@@ -205,7 +206,7 @@ public:
      */
     bool test(std::size_t bit) const
     {
-        LGRN_ASSERTMV(bit < m_size, "Bit position out of range", bit, m_size);
+        LGRN_ASSERTMV_CHEAP(bit < m_size, "Bit position out of range", bit, m_size);
 
         RowBit const pos = bit_at(bit);
 
@@ -243,7 +244,7 @@ public:
      */
     void set(std::size_t bit)
     {
-        LGRN_ASSERTMV(bit < m_size, "Bit position out of range", bit, m_size);
+        LGRN_ASSERTMV_CHEAP(bit < m_size, "Bit position out of range", bit, m_size);
         block_set_recurse(0, bit_at(bit));
     }
 
@@ -254,7 +255,7 @@ public:
      */
     void reset(std::size_t bit)
     {
-        LGRN_ASSERTMV(bit < m_size, "Bit position out of range", bit, m_size);
+        LGRN_ASSERTMV_CHEAP(bit < m_size, "Bit position out of range", bit, m_size);
         block_reset_recurse(0, bit_at(bit));
     }
 
@@ -324,6 +325,17 @@ public:
      */
     BLOCK_INT_T const* data() const noexcept { return m_blocks.get(); }
 
+    /**
+     * @brief Memory used by all rows, and occupancy of the bottom row
+     */
+    MemoryStats memory_stats() const noexcept
+    {
+        MemoryStats out{m_blockCount * sizeof(BLOCK_INT_T), m_blockCount * sizeof(BLOCK_INT_T)};
+        BLOCK_INT_T const* const pRow0 = m_blocks.get() + m_rows[0].m_offset;
+        count_word_occupancy<true>(out, pRow0, pRow0 + m_rows[0].m_size);
+        return out;
+    }
+
 private:
 
     /**
@@ -0,0 +1,379 @@
+/**
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: 2026 Neal Nicdao <chrisnicdao0@gmail.com>
+ */
+#pragma once
+
+#include "intarray_multimap.hpp" // for Span
+
+#include "../id_management/keyed_vec_stl.hpp"
+#include "../id_management/null.hpp"
+#include "../utility/asserts.hpp"
+#include "../utility/memory_stats.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace lgrn
+{
+
+/**
+ * @brief Tree of IDs stored in depth-first order, for cache-friendly top-down propagation
+ *
+ * Nodes are kept in a flat array in depth-first pre-order, where each node is followed by all of
+ * its descendants. Iterating this array in order always visits a parent before its children, so
+ * propagating values down the tree (eg: transforms) is a single linear pass. Each subtree is a
+ * contiguous range, see subtree().
+ *
+ * For parallel propagation, update_levels() groups nodes by depth with a counting sort. Nodes of
+ * the same level don't depend on each other, and are still in depth-first order within a level.
+ *
+ * Modifications shift the arrays after the modified position, costing O(n) like an
+ * std::vector::insert. Multiple trees (roots) are supported.
+ *
+ * @tparam SIZE_T Integer type used for positions, descendant counts, and depths
+ */
+template<typename ID_T, typename SIZE_T = std::uint32_t>
+class Hierarchy
+{
+    static constexpr SIZE_T smc_null = std::numeric_limits<SIZE_T>::max();
+
+public:
+
+    using Span_t = Span<ID_T const>;
+
+    /**
+     * @brief Resize to fit IDs up to n
+     */
+    void ids_reserve(std::size_t n)
+    {
+        m_idToPos   .resize(n, smc_null);
+        m_idToParent.resize(n, id_null<ID_T>());
+    }
+
+    std::size_t ids_capacity() const noexcept { return m_idToPos.size(); }
+
+    /**
+     * @return Number of nodes in the hierarchy
+     */
+    std::size_t size() const noexcept { return m_posToId.size(); }
+
+    bool contains(ID_T const id) const noexcept
+    {
+        return std::size_t(id) < m_idToPos.size() && m_idToPos[id] != smc_null;
+    }
+
+    /**
+     * @brief Add a new node as the last child of a parent
+     *
+     * @param parent [in] Parent node, or id_null to add a new root
+     */
+    void insert(ID_T const id, ID_T const parent = id_null<ID_T>())
+    {
+        LGRN_ASSERTMV(std::size_t(id) < m_idToPos.size(), "ID out of range, use ids_reserve",
+                      std::size_t(id), m_idToPos.size());
+        LGRN_ASSERTMV( ! contains(id), "ID already in hierarchy", std::size_t(id));
+        LGRN_ASSERTMV(parent == id_null<ID_T>() || contains(parent), "Parent not in hierarchy",
+                      std::size_t(parent));
+
+        SIZE_T const pos   = subtree_end(parent);
+        SIZE_T const depth = (parent == id_null<ID_T>()) ? 0 : m_posDepth[m_idToPos[parent]] + 1;
+
+        m_posToId         .insert(m_posToId.begin() + pos, id);
+        m_posDescendants  .insert(m_posDescendants.begin() + pos, 0);
+        m_posDepth        .insert(m_posDepth.begin() + pos, depth);
+        m_idToParent[id] = parent;
+
+        reindex(pos);
+        ancestors_add(parent, 1);
+        m_levelsDirty = true;
+    }
+
+    /**
+     * @brief Remove a node and all of its descendants
+     */
+    void remove(ID_T const id)
+    {
+        LGRN_ASSERTMV(contains(id), "ID not in hierarchy", std::size_t(id));
+
+        SIZE_T const first = m_idToPos[id];
+        SIZE_T const count = m_posDescendants[first] + 1;
+
+        ancestors_sub(m_idToParent[id], count);
+
+        for (SIZE_T i = first; i < first + count; ++i)
+        {
+            ID_T const removed = m_posToId[i];
+            m_idToPos[removed]    = smc_null;
+            m_idToParent[removed] = id_null<ID_T>();
+        }
+
+        m_posToId       .erase(m_posToId.begin() + first,        m_posToId.begin() + first + count);
+        m_posDescendants.erase(m_posDescendants.begin() + first, m_posDescendants.begin() + first + count);
+        m_posDepth      .erase(m_posDepth.begin() + first,       m_posDepth.begin() + first + count);
+
+        reindex(first);
+        m_levelsDirty = true;
+    }
+
+    /**
+     * @brief Move a node and all of its descendants to become the last child of another parent
+     *
+     * @param newParent [in] New parent, or id_null to make it a root. Must not be a descendant.
+     */
+    void reparent(ID_T const id, ID_T const newParent)
+    {
+        LGRN_ASSERTMV(contains(id), "ID not in hierarchy", std::size_t(id));
+        LGRN_ASSERTMV(newParent == id_null<ID_T>() || contains(newParent), "Parent not in hierarchy",
+                      std::size_t(newParent));
+
+        SIZE_T const first = m_idToPos[id];
+        SIZE_T const count = m_posDescendants[first] + 1;
+
+        LGRN_ASSERTMV(newParent == id_null<ID_T>()
+                      || m_idToPos[newParent] < first || m_idToPos[newParent] >= first + count,
+                      "Can't reparent a node to itself or its descendants",
+                      std::size_t(id), std::size_t(newParent));
+
+        // Position to insert at, as if the subtree was not removed yet
+        SIZE_T const dest = subtree_end(newParent);
+
+        ancestors_sub(m_idToParent[id], count);
+        m_idToParent[id] = newParent;
+
+        SIZE_T const oldDepth = m_posDepth[first];
+        SIZE_T const newDepth = (newParent == id_null<ID_T>()) ? 0 : m_posDepth[m_idToPos[newParent]] + 1;
+        for (SIZE_T i = first; i < first + count; ++i)
+        {
+            m_posDepth[i] = m_posDepth[i] - oldDepth + newDepth;
+        }
+
+        // Rotate the subtree into place instead of erasing and inserting, so only the range between
+        // the old and new positions is touched
+        if (dest > first + count)
+        {
+            // Move forwards. dest is past the subtree, so rotating [first, dest) works
+            rotate_all(first, first + count, dest);
+            reindex(first, dest);
+        }
+        else if (dest < first)
+        {
+            // Move backwards
+            rotate_all(dest, first, first + count);
+            reindex(dest, first + count);
+        }
+
+        ancestors_add(newParent, count);
+        m_levelsDirty = true;
+    }
+
+    /**
+     * @return Parent of a node, or id_null for roots
+     */
+    ID_T parent(ID_T const id) const noexcept
+    {
+        LGRN_ASSERTMV(contains(id), "ID not in hierarchy", std::size_t(id));
+        return m_idToParent[id];
+    }
+
+    /**
+     * @return Distance from the root, where roots have a depth of 0
+     */
+    SIZE_T depth(ID_T const id) const noexcept
+    {
+        LGRN_ASSERTMV(contains(id), "ID not in hierarchy", std::size_t(id));
+        return m_posDepth[m_idToPos[id]];
+    }
+
+    SIZE_T descendant_count(ID_T const id) const noexcept
+    {
+        LGRN_ASSERTMV(contains(id), "ID not in hierarchy", std::size_t(id));
+        return m_posDescendants[m_idToPos[id]];
+    }
+
+    /**
+     * @return Position of a node in depth-first order
+     */
+    SIZE_T position(ID_T const id) const noexcept
+    {
+        LGRN_ASSERTMV(contains(id), "ID not in hierarchy", std::size_t(id));
+        return m_idToPos[id];
+    }
+
+    /**
+     * @return All nodes in depth-first order
+     */
+    Span_t dfs() const noexcept
+    {
+        return {m_posToId.data(), m_posToId.size()};
+    }
+
+    /**
+     * @return A node followed by all of its descendants in depth-first order
+     */
+    Span_t subtree(ID_T const id) const noexcept
+    {
+        SIZE_T const pos = position(id);
+        return {m_posToId.data() + pos, std::size_t(m_posDescendants[pos]) + 1};
+    }
+
+    /**
+     * @brief Call a function for each direct child of a node, in order
+     *
+     * @param parent [in] Parent node, or id_null to iterate roots
+     */
+    template<typename FUNC_T>
+    void for_each_child(ID_T const parent, FUNC_T&& func) const
+    {
+        SIZE_T pos;
+        SIZE_T last;
+        if (parent == id_null<ID_T>())
+        {
+            pos  = 0;
+            last = SIZE_T(m_posToId.size());
+        }
+        else
+        {
+            SIZE_T const parentPos = position(parent);
+            pos  = parentPos + 1;
+            last = parentPos + 1 + m_posDescendants[parentPos];
+        }
+
+        // Skip over each child's descendants to get to the next child
+        while (pos < last)
+        {
+            func(m_posToId[pos]);
+            pos += m_posDescendants[pos] + 1;
+        }
+    }
+
+    /**
+     * @brief Group nodes by depth, required before using level()
+     *
+     * Does nothing if nothing changed since the last call.
+     */
+    void update_levels()
+    {
+        if ( ! m_levelsDirty )
+        {
+            return;
+        }
+
+        SIZE_T const levelCount = m_posDepth.empty()
+                                ? 0 : *std::max_element(m_posDepth.begin(), m_posDepth.end()) + 1;
+
+        // Counting sort by depth. Stable, so each level stays in depth-first order.
+        m_levelOffsets.assign(std::size_t(levelCount) + 1, 0);
+        for (SIZE_T const depth : m_posDepth)
+        {
+            ++ m_levelOffsets[std::size_t(depth) + 1];
+        }
+        for (std::size_t i = 1; i < m_levelOffsets.size(); ++i)
+        {
+            m_levelOffsets[i] += m_levelOffsets[i - 1];
+        }
+
+        m_levelIds.resize(m_posToId.size());
+        std::vector<SIZE_T> writePos(m_levelOffsets.begin(), m_levelOffsets.end() - 1);
+        for (std::size_t pos = 0; pos < m_posToId.size(); ++pos)
+        {
+            m_levelIds[writePos[m_posDepth[pos]] ++] = m_posToId[pos];
+        }
+
+        m_levelsDirty = false;
+    }
+
+    std::size_t level_count() const noexcept
+    {
+        LGRN_ASSERTM( ! m_levelsDirty, "Levels are out of date, call update_levels");
+        return m_levelOffsets.empty() ? 0 : m_levelOffsets.size() - 1;
+    }
+
+    /**
+     * @return All nodes of a certain depth
+     */
+    Span_t level(std::size_t depth) const noexcept
+    {
+        LGRN_ASSERTM( ! m_levelsDirty, "Levels are out of date, call update_levels");
+        LGRN_ASSERTV(depth < level_count(), depth, level_count());
+        return {m_levelIds.data() + m_levelOffsets[depth],
+                std::size_t(m_levelOffsets[depth + 1] - m_levelOffsets[depth])};
+    }
+
+    MemoryStats memory_stats() const noexcept
+    {
+        return sum_memory_stats(m_posToId, m_posDescendants, m_posDepth, m_idToPos, m_idToParent,
+                                m_levelIds, m_levelOffsets);
+    }
+
+private:
+
+    /**
+     * @return Position right after a node's last descendant, or the end for id_null
+     */
+    SIZE_T subtree_end(ID_T const parent) const noexcept
+    {
+        if (parent == id_null<ID_T>())
+        {
+            return SIZE_T(m_posToId.size());
+        }
+        SIZE_T const parentPos = m_idToPos[parent];
+        return parentPos + 1 + m_posDescendants[parentPos];
+    }
+
+    void ancestors_add(ID_T ancestor, SIZE_T count) noexcept
+    {
+        while (ancestor != id_null<ID_T>())
+        {
+            m_posDescendants[m_idToPos[ancestor]] += count;
+            ancestor = m_idToParent[ancestor];
+        }
+    }
+
+    void ancestors_sub(ID_T ancestor, SIZE_T count) noexcept
+    {
+        while (ancestor != id_null<ID_T>())
+        {
+            m_posDescendants[m_idToPos[ancestor]] -= count;
+            ancestor = m_idToParent[ancestor];
+        }
+    }
+
+    void rotate_all(SIZE_T first, SIZE_T middle, SIZE_T last)
+    {
+        std::rotate(m_posToId.begin() + first,        m_posToId.begin() + middle,        m_posToId.begin() + last);
+        std::rotate(m_posDescendants.begin() + first, m_posDescendants.begin() + middle, m_posDescendants.begin() + last);
+        std::rotate(m_posDepth.begin() + first,       m_posDepth.begin() + middle,       m_posDepth.begin() + last);
+    }
+
+    void reindex(SIZE_T first) noexcept
+    {
+        reindex(first, SIZE_T(m_posToId.size()));
+    }
+
+    void reindex(SIZE_T first, SIZE_T last) noexcept
+    {
+        for (SIZE_T pos = first; pos < last; ++pos)
+        {
+            m_idToPos[m_posToId[pos]] = pos;
+        }
+    }
+
+    // [position] -> Node data, in depth-first order
+    std::vector<ID_T>               m_posToId;
+    std::vector<SIZE_T>             m_posDescendants;
+    std::vector<SIZE_T>             m_posDepth;
+
+    KeyedVec<ID_T, SIZE_T>          m_idToPos;
+    KeyedVec<ID_T, ID_T>            m_idToParent;
+
+    // Nodes sorted by depth, and where each level starts
+    std::vector<ID_T>               m_levelIds;
+    std::vector<SIZE_T>             m_levelOffsets;
+    bool                            m_levelsDirty{false};
+
+}; // class Hierarchy
+
+} // namespace lgrn
@@ -5,9 +5,15 @@
 #pragma once
 
 #include "../utility/asserts.hpp"
+#include "../utility/memory_stats.hpp"
+#include "../utility/trace.hpp"
 
 #include <algorithm>
+#include <cstring>
+#include <map>
 #include <memory>
+#include <new>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -67,14 +73,171 @@ public:
         return NewPartition{ newOffset, newNum };
     }
 
+    /**
+     * @brief Free partitions directly next to an erased partition, that it can merge with
+     */
+    struct EraseNeighbors
+    {
+        bool m_left;    // Free partition directly before
+        bool m_right;   // Free partition directly after
+        bool m_last;    // No right free partition, and the last free partition is directly after
+    };
+
+    /**
+     * @param pLeft     [in] Closest free partition before the erased one, or nullptr
+     * @param pRight    [in] Closest free partition after the erased one, or nullptr
+     */
+    static constexpr EraseNeighbors erase_neighbors(
+            Free const* pLeft, Free const* pRight, Free const& last, INT_T partition) noexcept
+    {
+        return {
+            (pLeft  != nullptr) && (pLeft->m_partitionNum + pLeft->m_partitionCount == partition),
+            (pRight != nullptr) && (pRight->m_partitionNum == partition + 1),
+            (pRight == nullptr) && (last.m_partitionNum == partition + 1) };
+    }
+
+    /**
+     * @brief Merge a free partition directly before the last free partition into it
+     */
+    static void absorb_into_last(Free& rLast, Free const& free) noexcept
+    {
+        LGRN_ASSERT(free.m_partitionNum + free.m_partitionCount == rLast.m_partitionNum);
+        rLast.m_size           += rLast.m_offset - free.m_offset;
+        rLast.m_offset         = free.m_offset;
+        rLast.m_partitionNum   = free.m_partitionNum;
+    }
+
+    struct DataMoved
+    {
+        SIZE_T m_offsetSrc;
+        SIZE_T m_offsetDst;
+        SIZE_T m_size;
+    };
+
+    /**
+     * @brief Shift partitions between two free partitions left to replace the first, merging it
+     *        into the next
+     *
+     * Array parameters can be any type indexable with operator[].
+     *
+     * @param rFirst            [ref] First free partition, moves right as partitions are shifted
+     * @param rNext             [ref] Next free partition after rFirst
+     * @param rFirstMerged      [out] Set true when rFirst is fully merged and should be removed
+     * @param maxMovesHint      [in] Stop after moving about this much data
+     *
+     * @return Range of data that must be moved from offsetSrc to offsetDst
+     */
+    template<typename PRTN_TO_ID_T, typename ID_TO_PRTN_T, typename ID_TO_DATA_T>
+    static DataMoved pack_step(
+            Free&           rFirst,
+            Free&           rNext,
+            bool&           rFirstMerged,
+            PRTN_TO_ID_T&   rPartitionToId,
+            std::size_t     partitionCapacity,
+            ID_TO_PRTN_T&   rIdToPartition,
+            ID_TO_DATA_T&   rIdToData,
+            SIZE_T          maxMovesHint) noexcept
+    {
+        // strategy: shift partitions between rFirst and rNext left to replace
+        //           rFirst, merging it into rNext
+
+        SIZE_T const offsetSrc = rFirst.m_offset + rFirst.m_size;
+        SIZE_T const offsetDst = rFirst.m_offset;
+
+        SIZE_T movedData = 0;
+        INT_T movedPrtn = 0;
+        INT_T currentPrtn = rFirst.m_partitionNum;
+
+        rFirstMerged = false;
+
+        while (true)
+        {
+            INT_T const nextPrtn = currentPrtn + rFirst.m_partitionCount;
+            INT_T const nextId = (std::size_t(nextPrtn) < partitionCapacity)
+                               ? INT_T(rPartitionToId[nextPrtn]) : smc_null;
+
+            if (nextId != smc_null)
+            {
+                // move next partition left to replace current free partition
+                rPartitionToId[currentPrtn] = nextId;
+                rPartitionToId[nextPrtn] = smc_null;
+
+                rIdToPartition[nextId] = currentPrtn;
+                rIdToData[nextId].m_offset -= rFirst.m_size;
+
+                movedPrtn ++;
+                movedData += rIdToData[nextId].m_size;
+
+                currentPrtn ++;
+            }
+            else
+            {
+                // hit next free partition, merge rFirst into rNext
+                LGRN_ASSERT(nextPrtn == rNext.m_partitionNum);
+                rNext.m_offset          -= rFirst.m_size;
+                rNext.m_partitionNum    -= rFirst.m_partitionCount;
+                rNext.m_partitionCount  += rFirst.m_partitionCount;
+                rNext.m_size            += rFirst.m_size;
+
+                rFirstMerged = true;
+                break;
+            }
+
+            if (movedData > maxMovesHint)
+            {
+                // maximum moves exceeded, rFirst is now right after the moved partitions
+                rFirst.m_offset         += movedData;
+                rFirst.m_partitionNum   += movedPrtn;
+                break;
+            }
+        }
+
+        return {offsetSrc, offsetDst, movedData};
+    }
+
 }; // class Partition
 
-template<typename INT_T, typename SIZE_T>
+/**
+ * @brief Per-ID data span that can also store up to N elements directly (small-buffer
+ *        optimization)
+ *
+ * m_offset is only meaningful when m_size > N, otherwise the same bytes hold the elements.
+ */
+template<typename SIZE_T, typename DATA_T, std::size_t N>
+struct DataSpanInline
+{
+    static_assert(std::is_trivially_copyable_v<DATA_T>, "Inline data must be trivially copyable");
+
+    DATA_T* inline_data() noexcept
+    {
+        return std::launder(reinterpret_cast<DATA_T*>(m_inline));
+    }
+
+    DATA_T const* inline_data() const noexcept
+    {
+        return std::launder(reinterpret_cast<DATA_T const*>(m_inline));
+    }
+
+    SIZE_T m_size{0};
+    union
+    {
+        SIZE_T m_offset{0};
+        alignas(DATA_T) unsigned char m_inline[N * sizeof(DATA_T)];
+    };
+};
+
+/**
+ * @tparam INLINE_N Partitions with this many elements or less are inline, see DataSpanInline.
+ *                  Must match DATASPAN_T. 0 to disable.
+ */
+template<typename INT_T, typename SIZE_T,
+         typename DATASPAN_T = typename PartitionUtils<INT_T, SIZE_T>::DataSpan,
+         std::size_t INLINE_N = 0>
 struct PartitionDescStl
 {
     using Utils_t           = PartitionUtils<INT_T, SIZE_T>;
     using NewPartition_t    = typename Utils_t::NewPartition;
-    using DataSpan_t        = typename Utils_t::DataSpan;
+    using DataSpan_t        = DATASPAN_T;
     using Free_t            = typename Utils_t::Free;
 
     static constexpr INT_T const smc_null = Utils_t::smc_null;
@@ -84,11 +247,13 @@ struct PartitionDescStl
         m_idToData.resize(maxIds);
         m_idToPartition.resize(maxIds, smc_null);
 
-        m_partitionToId.resize(maxIds, smc_null);
-        m_free.reserve(maxIds / 2);
+        if (m_partitionToId.size() < std::size_t(maxIds))
+        {
+            m_partitionToId.resize(maxIds, smc_null);
+        }
     }
 
-    bool id_in_range(INT_T id) const noexcept { return id < m_idToPartition.size(); }
+    bool id_in_range(INT_T id) const noexcept { return std::size_t(id) < m_idToPartition.size(); }
 
     typename Utils_t::Free& last_free()
     {
@@ -101,6 +266,15 @@ struct PartitionDescStl
     NewPartition_t create(INT_T id, SIZE_T size)
     {
         NewPartition_t prtn = Utils_t::create_partition(size, m_freeLast);
+
+        if (m_partitionToId.size() <= std::size_t(prtn.m_partitionNum))
+        {
+            // Free partitions (holes) use up partition numbers too, so there can be more
+            // partitions than IDs when fragmented
+            m_partitionToId.resize(std::max<std::size_t>(m_partitionToId.size() * 2,
+                                                         prtn.m_partitionNum + 1), smc_null);
+        }
+
         m_partitionToId[prtn.m_partitionNum] = id;
         m_idToPartition[id] = prtn.m_partitionNum;
         DataSpan_t &rSpan = m_idToData[id];
@@ -112,105 +286,234 @@ struct PartitionDescStl
         return prtn;
     }
 
+    /**
+     * @brief Create a partition that has no space in the data buffer, as its data is stored
+     *        within m_idToData
+     *
+     * Instead of a partition number, m_idToPartition holds the ID's index in m_inlineIds.
+     */
+    void create_inline(INT_T id, SIZE_T size)
+    {
+        static_assert(INLINE_N != 0, "Inline partitions are disabled");
+        LGRN_ASSERTMV(size <= INLINE_N, "Partition too large to be inline", size, INLINE_N);
+
+        m_idToPartition[id] = INT_T(m_inlineIds.size());
+        m_inlineIds.push_back(id);
+        m_idToData[id].m_size = size;
+        m_idCount ++;
+    }
+
+    /**
+     * @param id [in] Existing ID
+     */
+    bool is_inline(INT_T id) const noexcept
+    {
+        if constexpr (INLINE_N != 0)
+        {
+            return m_idToData[id].m_size <= INLINE_N;
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    void erase_inline(INT_T id) noexcept
+    {
+        // Swap-and-pop from m_inlineIds
+        INT_T const index   = m_idToPartition[id];
+        INT_T const lastId  = m_inlineIds.back();
+        m_inlineIds[index]          = lastId;
+        m_idToPartition[lastId]     = index;
+        m_inlineIds.pop_back();
+
+        m_idToPartition[id]     = smc_null;
+        m_idToData[id].m_size   = 0;
+        m_idCount --;
+    }
+
+    /**
+     * @brief Erase a single partition, merging it with adjacent free partitions. O(log n) of the
+     *        number of free partitions.
+     *
+     * @return Location of the erased partition's data
+     */
     Free_t erase(INT_T id)
     {
         LGRN_ASSERTM(exists(id), "");
 
+        if (is_inline(id))
+        {
+            erase_inline(id);
+            return Free_t{0, smc_null, 0, 0};
+        }
+
         // get partition number
         INT_T const partition = std::exchange(m_idToPartition[id], smc_null);
+        SIZE_T const dataSize = std::exchange(m_idToData[id].m_size, 0);
+
         m_partitionToId[partition] = smc_null;
-        DataSpan_t const data = m_idToData[id];
+        typename Utils_t::DataSpan const data{m_idToData[id].m_offset, dataSize};
+        m_idToData[id].m_offset = 0;
 
-        Free_t free{data.m_offset, partition, 1, data.m_size};
+        Free_t const erased{data.m_offset, partition, 1, data.m_size};
 
-        if (m_free.empty())
+        auto const itNext = m_free.upper_bound(partition);
+        auto const itPrev = (itNext != m_free.begin()) ? std::prev(itNext) : m_free.end();
+
+        auto const [mergeLeft, mergeRight, mergeLast] = Utils_t::erase_neighbors(
+                (itPrev != m_free.end()) ? &itPrev->second : nullptr,
+                (itNext != m_free.end()) ? &itNext->second : nullptr,
+                m_freeLast, partition);
+
+        if (mergeLeft)
         {
-            m_free.push_back(std::move(free));
+            Free_t &rPrev = itPrev->second;
+            rPrev.m_partitionCount  += 1;
+            rPrev.m_size            += data.m_size;
+
+            if (mergeRight)
+            {
+                rPrev.m_partitionCount  += itNext->second.m_partitionCount;
+                rPrev.m_size            += itNext->second.m_size;
+                m_free.erase(itNext);
+            }
+            else if (mergeLast)
+            {
+                Utils_t::absorb_into_last(m_freeLast, rPrev);
+                m_free.erase(itPrev);
+            }
+        }
+        else if (mergeRight)
+        {
+            // Grow next free partition left. Changes its key, but not its order
+            auto node = m_free.extract(itNext);
+            node.key() = partition;
+            Free_t &rNext = node.mapped();
+            rNext.m_offset          = data.m_offset;
+            rNext.m_partitionNum    = partition;
+            rNext.m_partitionCount  += 1;
+            rNext.m_size            += data.m_size;
+            m_free.insert(std::move(node));
+        }
+        else if (mergeLast)
+        {
+            Utils_t::absorb_into_last(m_freeLast, erased);
         }
         else
         {
-            auto it = std::upper_bound(
-                    std::begin(m_free), std::end(m_free), free,
-            [] (Free_t const& lhs, Free_t const& rhs) -> bool {
-                return lhs.m_partitionNum > rhs.m_partitionNum;
-            });
-            m_free.insert(it, std::move(free));
+            m_free.emplace_hint(itNext, partition, erased);
         }
 
         m_dataUsed -= data.m_size;
         m_idCount --;
-        return free;
+        return erased;
     }
 
-    struct DataMoved
-    {
-        SIZE_T m_offsetSrc;
-        SIZE_T m_offsetDst;
-        SIZE_T m_size;
-    };
-
     /**
-     * @return
+     * @brief Erase many partitions, then rebuild all free partitions in a single linear pass
+     *
+     * Preferred over many individual calls to erase() when erasing a large portion of partitions.
+     *
+     * @param first [in] Iterator to IDs to erase. IDs must exist and not be repeated
+     * @param last  [in] Sentinel of IDs
      */
-    DataMoved pack_step(SIZE_T maxMovesHint) noexcept
+    template<typename ITER_T, typename SNTL_T>
+    void erase_many(ITER_T first, SNTL_T const last)
     {
-        if (m_free.empty())
+        for (; first != last; ++first)
         {
-            return {0, 0, 0};
-        }
-        Free_t &rFirst = m_free.back();
-        Free_t &rNext = (m_free.size() == 1) ? m_freeLast : m_free[m_free.size() - 2];
+            INT_T const id = *first;
+            LGRN_ASSERTMV(exists(id), "ID does not exist", id);
 
-        // strategy: shift partitions between rFirst and rNext left to replace
-        //           rFirst, merging it into rNext
+            if (is_inline(id))
+            {
+                erase_inline(id);
+                continue;
+            }
 
-        SIZE_T const offsetSrc = rFirst.m_offset + rFirst.m_size;
-        SIZE_T const offsetDst = rFirst.m_offset;
+            INT_T const partition = std::exchange(m_idToPartition[id], smc_null);
+            SIZE_T const dataSize = std::exchange(m_idToData[id].m_size, 0);
+            m_idCount --;
 
-        SIZE_T movedData = 0;
-        SIZE_T movedPrtn = 0;
-        INT_T currentPrtn = rFirst.m_partitionNum;
+            m_partitionToId[partition] = smc_null;
+            m_idToData[id].m_offset = 0;
+            m_dataUsed -= dataSize;
+        }
 
-        while (true)
-        {
-            INT_T const nextPrtn = currentPrtn + rFirst.m_partitionCount;
-            INT_T const nextId = (nextPrtn < m_partitionToId.size())
-                               ? m_partitionToId[nextPrtn] : smc_null;
+        // Partitions are contiguous in partition number order, so each run of free partitions
+        // spans from the end of the previous partition to the start of the next one.
+        m_free.clear();
 
-            if (nextId != smc_null)
+        INT_T const prtnEnd = m_freeLast.m_partitionNum;
+        INT_T       prtn    = 0;
+        SIZE_T      dataEnd = 0;
+        while (prtn < prtnEnd)
+        {
+            INT_T const id = m_partitionToId[prtn];
+            if (id != smc_null)
             {
-                // move next partition left to replace current free partition
-                m_partitionToId[currentPrtn] = nextId;
-                m_partitionToId[nextPrtn] = smc_null;
-
-                m_idToPartition[nextId] = currentPrtn;
-                m_idToData[nextId].m_offset -= rFirst.m_size;
+                dataEnd = m_idToData[id].m_offset + m_idToData[id].m_size;
+                ++prtn;
+                continue;
+            }
 
-                movedPrtn ++;
-                movedData += m_idToData[nextId].m_size;
+            INT_T const runFirst = prtn;
+            while (prtn < prtnEnd && m_partitionToId[prtn] == smc_null)
+            {
+                ++prtn;
+            }
 
-                currentPrtn ++;
+            Free_t const free{dataEnd, runFirst, INT_T(prtn - runFirst), 0};
+            if (prtn == prtnEnd)
+            {
+                Utils_t::absorb_into_last(m_freeLast, free);
             }
             else
             {
-                // hit next free partition, merge rFirst into rNext
-                LGRN_ASSERT(nextPrtn == rNext.m_partitionNum);
-                rNext.m_offset          -= rFirst.m_size;
-                rNext.m_partitionNum    -= rFirst.m_partitionCount;
-                rNext.m_partitionCount  += rFirst.m_partitionCount;
-                rNext.m_size            += rFirst.m_size;
-
-                m_free.pop_back(); // invalidates rFirst
-                break;
+                SIZE_T const nextOffset = m_idToData[m_partitionToId[prtn]].m_offset;
+                Free_t &rFree = m_free.emplace_hint(m_free.end(), runFirst, free)->second;
+                rFree.m_size = nextOffset - dataEnd;
             }
+        }
+    }
 
-            if (movedData > maxMovesHint)
+    using DataMoved = typename Utils_t::DataMoved;
+
+    /**
+     * @brief Move some partitions to remove the first free partition (lowest partition number)
+     */
+    DataMoved pack_step(SIZE_T maxMovesHint) noexcept
+    {
+        if (m_free.empty())
+        {
+            return {0, 0, 0};
+        }
+        auto const itFirst = m_free.begin();
+        auto const itNext  = std::next(itFirst);
+        Free_t &rFirst = itFirst->second;
+        Free_t &rNext  = (itNext == m_free.end()) ? m_freeLast : itNext->second;
+
+        bool firstMerged = false;
+        DataMoved const moved = Utils_t::pack_step(
+                rFirst, rNext, firstMerged, m_partitionToId, m_partitionToId.size(),
+                m_idToPartition, m_idToData, maxMovesHint);
+
+        // Partition numbers of free partitions may have changed, keep keys in sync
+        if (firstMerged)
+        {
+            m_free.erase(itFirst);
+            if (itNext != m_free.end())
             {
-                break; // maximum moves exceeded
+                rekey(itNext);
             }
         }
+        else
+        {
+            rekey(itFirst);
+        }
 
-        return {offsetSrc, offsetDst, movedData};
+        return moved;
     }
 
     bool exists(INT_T id) const noexcept
@@ -218,15 +521,53 @@ struct PartitionDescStl
         return m_idToPartition[id] != smc_null;
     }
 
+    /**
+     * @brief Bookkeeping memory, and holes in a data buffer with elements of dataElemSize bytes
+     *
+     * Free partitions are counted as one map value each, ignoring node overhead.
+     */
+    MemoryStats memory_stats(std::size_t dataElemSize) const noexcept
+    {
+        MemoryStats out = sum_memory_stats(m_partitionToId, m_idToPartition, m_idToData,
+                                           m_inlineIds);
+
+        std::size_t const freeBytes = m_free.size() * sizeof(typename decltype(m_free)::value_type);
+        out.m_bytesReserved += freeBytes;
+        out.m_bytesUsed     += freeBytes;
+
+        out.m_holeCount = m_free.size();
+        for (auto const& [_, free] : m_free)
+        {
+            out.m_largestHoleBytes = std::max(out.m_largestHoleBytes, free.m_size * dataElemSize);
+        }
+        return out;
+    }
+
+    template<typename IT_T>
+    void rekey(IT_T it)
+    {
+        if (it->first != it->second.m_partitionNum)
+        {
+            auto node = m_free.extract(it);
+            node.key() = node.mapped().m_partitionNum;
+            m_free.insert(std::move(node));
+        }
+    }
+
     std::vector<INT_T>          m_partitionToId;
 
     Free_t                      m_freeLast;
-    std::vector<Free_t>         m_free;
+
+    // Free partitions (holes) before m_freeLast, keyed by partition number
+    std::map<INT_T, Free_t>     m_free;
     std::size_t                 m_dataUsed{0};
     std::size_t                 m_idCount{0};
 
     std::vector<INT_T>          m_idToPartition;
     std::vector<DataSpan_t>     m_idToData;
+
+    // IDs of inline partitions, in no particular order
+    std::vector<INT_T>          m_inlineIds;
 };
 
 
@@ -251,6 +592,7 @@ public:
 
     constexpr std::size_t size() const noexcept { return m_size; }
     constexpr DATA_T& operator[](std::size_t i) const noexcept { return m_data[i]; }
+    constexpr DATA_T* data() const noexcept { return m_data; }
     constexpr DATA_T* begin() const noexcept { return m_data; }
     constexpr DATA_T* end() const noexcept { return m_data + m_size; }
 
@@ -260,19 +602,29 @@ private:
 };
 #endif // __cpp_lib_span
 
+/**
+ * @brief Maps integer IDs to variable-sized arrays of data
+ *
+ * @tparam INLINE_N Partitions with this many elements or less are stored inline within the
+ *                  per-ID descriptor instead of the shared data buffer, saving an indirection for
+ *                  small partitions. Requires trivially copyable data. 0 to disable.
+ */
 template< typename INT_T, typename DATA_T,
-          typename ALLOC_T = std::allocator<DATA_T> >
+          typename ALLOC_T = std::allocator<DATA_T>,
+          std::size_t INLINE_N = 0 >
 class IntArrayMultiMap
 {
     using alloc_traits_t    = std::allocator_traits<ALLOC_T>;
 
-    using PartitionDesc_t   = PartitionDescStl<INT_T, std::size_t>;
     using Utils_t           = PartitionUtils<INT_T, std::size_t>;
+    using DataSpan_t        = std::conditional_t<INLINE_N == 0,
+                                                 typename Utils_t::DataSpan,
+                                                 DataSpanInline<std::size_t, DATA_T, INLINE_N>>;
+    using PartitionDesc_t   = PartitionDescStl<INT_T, std::size_t, DataSpan_t, INLINE_N>;
 
     using NewPartition_t    = typename Utils_t::NewPartition;
     using Free_t            = typename Utils_t::Free;
 
-    using DataSpan_t        = typename Utils_t::DataSpan;
     using DataMoved_t       = typename PartitionDesc_t::DataMoved;
 
 public:
@@ -285,9 +637,44 @@ public:
         ids_reserve(idCapacity);
     }
 
-    IntArrayMultiMap(IntArrayMultiMap const& copy) = delete; // TODO
+    /**
+     * @brief Copy all partitions as-is, including fragmentation. See packed_copy()
+     *
+     * Trivially copyable data is copied with a single memcpy.
+     */
+    IntArrayMultiMap(IntArrayMultiMap const& copy)
+        : m_partitions{copy.m_partitions}
+        , m_allocator{alloc_traits_t::select_on_container_copy_construction(copy.m_allocator)}
+    {
+        if (copy.m_data == nullptr)
+        {
+            return;
+        }
+
+        m_data = alloc_traits_t::allocate(m_allocator, copy.m_dataSize);
+        m_dataSize = copy.m_dataSize;
 
-    IntArrayMultiMap(IntArrayMultiMap&& move)
+        if constexpr (std::is_trivially_copyable_v<DATA_T>)
+        {
+            // Copy everything up to the last partition, holes included
+            std::memcpy(m_data, copy.m_data, m_partitions.last_free().m_offset * sizeof(DATA_T));
+        }
+        else
+        {
+            for (INT_T prtn = 0; prtn < m_partitions.last_free().m_partitionNum; prtn ++)
+            {
+                INT_T const id = m_partitions.m_partitionToId[prtn];
+                if (id != PartitionDesc_t::smc_null)
+                {
+                    DataSpan_t const& span = m_partitions.m_idToData[id];
+                    std::uninitialized_copy_n(&copy.m_data[span.m_offset], span.m_size,
+                                              &m_data[span.m_offset]);
+                }
+            }
+        }
+    }
+
+    IntArrayMultiMap(IntArrayMultiMap&& move) noexcept
         : m_partitions{std::move(move.m_partitions)}
         , m_allocator{std::move(move.m_allocator)}
         , m_data{std::exchange(move.m_data, nullptr)}
@@ -296,21 +683,69 @@ public:
 
     ~IntArrayMultiMap()
     {
-        if (nullptr != m_data)
+        destroy_all();
+    }
+
+    IntArrayMultiMap& operator=(IntArrayMultiMap const& copy)
+    {
+        if (this != &copy)
         {
-            // call destructors
-            for (INT_T prtnRead = 0; prtnRead < m_partitions.last_free().m_partitionNum; prtnRead ++)
+            *this = IntArrayMultiMap(copy);
+        }
+        return *this;
+    }
+
+    IntArrayMultiMap& operator=(IntArrayMultiMap&& move) noexcept
+    {
+        if (this != &move)
+        {
+            destroy_all();
+            m_partitions    = std::move(move.m_partitions);
+            m_allocator     = std::move(move.m_allocator);
+            m_data          = std::exchange(move.m_data, nullptr);
+            m_dataSize      = std::exchange(move.m_dataSize, 0);
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Copy all partitions into a new IntArrayMultiMap without any fragmentation
+     *
+     * Partitions keep their relative order in memory.
+     *
+     * @param dataCapacity [in] Data capacity of the copy, must fit data_size(). Defaults to
+     *                          the same capacity as this container.
+     */
+    IntArrayMultiMap packed_copy(std::size_t dataCapacity = 0) const
+    {
+        IntArrayMultiMap out;
+        out.ids_reserve(INT_T(ids_capacity()));
+        out.data_reserve((dataCapacity == 0) ? data_capacity() : dataCapacity);
+
+        LGRN_ASSERTMV(data_size() <= out.data_capacity(), "Data capacity too small",
+                      data_size(), out.data_capacity());
+
+        for (INT_T prtn = 0; prtn < m_partitions.m_freeLast.m_partitionNum; prtn ++)
+        {
+            INT_T const id = m_partitions.m_partitionToId[prtn];
+            if (id != PartitionDesc_t::smc_null)
             {
-                INT_T const id = m_partitions.m_partitionToId[prtnRead];
-                if (id != PartitionDesc_t::smc_null)
-                {
-                    DataSpan_t const& span = m_partitions.m_idToData[id];
-                    std::destroy_n(&m_data[span.m_offset], span.m_size);
-                }
+                DataSpan_t const& span = m_partitions.m_idToData[id];
+                std::uninitialized_copy_n(&m_data[span.m_offset], span.m_size,
+                                          out.create_uninitialized(id, span.m_size));
             }
+        }
 
-            alloc_traits_t::deallocate(m_allocator, m_data, m_dataSize);
+        if constexpr (INLINE_N != 0)
+        {
+            for (INT_T const id : m_partitions.m_inlineIds)
+            {
+                out.m_partitions.create_inline(id, m_partitions.m_idToData[id].m_size);
+                out.m_partitions.m_idToData[id] = m_partitions.m_idToData[id];
+            }
         }
+
+        return out;
     }
 
     bool contains(INT_T id) const
@@ -347,8 +782,11 @@ public:
         return m_partitions.used();
     }
 
-    void data_reserve(INT_T capacity)
+    void data_reserve(std::size_t capacity)
     {
+        LGRN_TRACE("IntArrayMultiMap::data_reserve");
+        LGRN_COUNTER("IntArrayMultiMap reallocations");
+
         DATA_T *newData = alloc_traits_t::allocate(m_allocator, capacity);
 
         Free_t &rLastFree = m_partitions.last_free();
@@ -393,6 +831,7 @@ public:
 
             m_partitions.m_free.clear();
             rLastFree.m_offset = writeOffset;
+            rLastFree.m_partitionNum = prtnWrite;
             rLastFree.m_size = capacity - writeOffset;
 
         }
@@ -457,6 +896,7 @@ public:
                     pWrite ++;
                 }
 
+                LGRN_COUNTER_ADD("IntArrayMultiMap pack moves", moved.m_size);
                 moveTotal += moved.m_size;
             }
         }
@@ -466,36 +906,196 @@ public:
 
     void erase(INT_T id)
     {
+        // Inline data is trivially destructible, and erase() returns a zero size for it
         Free_t free = m_partitions.erase(id);
-        std::destroy_n(&m_data[free.m_offset], free.m_size);
+        std::destroy_n(m_data + free.m_offset, free.m_size);
     }
 
-    Span<DATA_T> operator[] (INT_T id) noexcept
+    /**
+     * @brief Erase many IDs at once. Faster than individual erase() calls for large amounts
+     *
+     * @param first [in] Iterator to IDs to erase. IDs must exist and not be repeated
+     * @param last  [in] Sentinel of IDs
+     */
+    template<typename ITER_T, typename SNTL_T>
+    void erase_many(ITER_T first, SNTL_T const last)
     {
-        if (!m_partitions.exists(id) || !m_partitions.id_in_range(id))
+        for (ITER_T it = first; it != last; ++it)
         {
-            return { };
+            LGRN_ASSERTMV(contains(*it), "ID does not exist", *it);
+            if ( ! is_inline_size(m_partitions.m_idToData[*it].m_size) )
+            {
+                DataSpan_t const& span = m_partitions.m_idToData[*it];
+                std::destroy_n(&m_data[span.m_offset], span.m_size);
+            }
         }
-        DataSpan_t const &span = m_partitions.m_idToData[id];
-        return {&m_data[span.m_offset], span.m_size};
+        m_partitions.erase_many(first, last);
+    }
+
+    /**
+     * @return Span of a partition's data, or an empty span if the ID doesn't exist
+     */
+    Span<DATA_T> operator[] (INT_T id) noexcept
+    {
+        return impl_access(*this, id);
     }
 
     Span<DATA_T const> const operator[] (INT_T id) const noexcept
     {
-        if (!m_partitions.exists(id) || !m_partitions.id_in_range(id))
+        return impl_access(*this, id);
+    }
+
+    /**
+     * @brief Call a function for each partition in the order they are stored in memory
+     *
+     * This is a single linear sweep through the data buffer, unlike accessing every ID through
+     * operator[]. Inline partitions (see INLINE_N) are visited afterwards, in no particular order.
+     *
+     * @param func [in] Callable as void(INT_T id, Span<DATA_T> data)
+     */
+    template<typename FUNC_T>
+    void for_each_partition(FUNC_T&& func)
+    {
+        impl_for_each_partition(*this, std::forward<FUNC_T>(func));
+    }
+
+    /**
+     * @param func [in] Callable as void(INT_T id, Span<DATA_T const> data)
+     */
+    template<typename FUNC_T>
+    void for_each_partition(FUNC_T&& func) const
+    {
+        impl_for_each_partition(*this, std::forward<FUNC_T>(func));
+    }
+
+    /**
+     * @brief Memory used by the data buffer and bookkeeping, and holes in the data buffer
+     *
+     * Inline partitions are counted as part of the bookkeeping.
+     */
+    MemoryStats memory_stats() const noexcept
+    {
+        MemoryStats out = m_partitions.memory_stats(sizeof(DATA_T));
+        out.m_bytesReserved += m_dataSize * sizeof(DATA_T);
+        out.m_bytesUsed     += data_size() * sizeof(DATA_T);
+        return out;
+    }
+
+    /**
+     * @return true if there are no holes between partitions in the data buffer
+     */
+    bool is_packed() const noexcept
+    {
+        return m_partitions.m_free.empty();
+    }
+
+    /**
+     * @brief Access all data of all partitions as a single contiguous span
+     *
+     * Inline partitions (see INLINE_N) are not included.
+     *
+     * @warning Only valid when packed, see is_packed() and pack()
+     */
+    Span<DATA_T> data_packed() noexcept
+    {
+        LGRN_ASSERTM(is_packed(), "Data contains holes, call pack() first");
+        return {m_data, m_partitions.m_freeLast.m_offset};
+    }
+
+    Span<DATA_T const> data_packed() const noexcept
+    {
+        LGRN_ASSERTM(is_packed(), "Data contains holes, call pack() first");
+        return {m_data, m_partitions.m_freeLast.m_offset};
+    }
+
+private:
+
+    template<typename SELF_T>
+    static auto impl_access(SELF_T& rSelf, INT_T id) noexcept
+    {
+        using Data_t = std::conditional_t<std::is_const_v<SELF_T>, DATA_T const, DATA_T>;
+
+        // Non-existing IDs have a size of zero. Only m_idToData is accessed here.
+        if ( ! rSelf.m_partitions.id_in_range(id) )
         {
-            return { };
+            return Span<Data_t>{};
         }
-        DataSpan_t const &span = m_partitions.m_idToData[id];
-        return {&m_data[span.m_offset], span.m_size};
+        auto &rSpan = rSelf.m_partitions.m_idToData[id];
+        if constexpr (INLINE_N != 0)
+        {
+            if (rSpan.m_size <= INLINE_N)
+            {
+                return Span<Data_t>{rSpan.inline_data(), rSpan.m_size};
+            }
+        }
+        return Span<Data_t>{rSelf.m_data + rSpan.m_offset, rSpan.m_size};
     }
 
-private:
+    static constexpr bool is_inline_size(std::size_t size) noexcept
+    {
+        return (INLINE_N != 0) && (size <= INLINE_N);
+    }
+
+    template<typename SELF_T, typename FUNC_T>
+    static void impl_for_each_partition(SELF_T& rSelf, FUNC_T&& func)
+    {
+        using Data_t = std::conditional_t<std::is_const_v<SELF_T>, DATA_T const, DATA_T>;
+
+        PartitionDesc_t const& partitions = rSelf.m_partitions;
+        for (INT_T prtn = 0; prtn < partitions.m_freeLast.m_partitionNum; prtn ++)
+        {
+            INT_T const id = partitions.m_partitionToId[prtn];
+            if (id != PartitionDesc_t::smc_null)
+            {
+                DataSpan_t const& span = partitions.m_idToData[id];
+                func(id, Span<Data_t>{&rSelf.m_data[span.m_offset], span.m_size});
+            }
+        }
+
+        if constexpr (INLINE_N != 0)
+        {
+            for (INT_T const id : partitions.m_inlineIds)
+            {
+                func(id, impl_access(rSelf, id));
+            }
+        }
+    }
 
     DATA_T* create_uninitialized(INT_T id, std::size_t size)
     {
-         NewPartition_t prtn = m_partitions.create(id, size);
-         return &m_data[prtn.m_offset];
+        if constexpr (INLINE_N != 0)
+        {
+            if (is_inline_size(size))
+            {
+                m_partitions.create_inline(id, size);
+                return m_partitions.m_idToData[id].inline_data();
+            }
+        }
+
+        NewPartition_t prtn = m_partitions.create(id, size);
+        return &m_data[prtn.m_offset];
+    }
+
+    /**
+     * @brief Call destructors of all contained data, and deallocate
+     */
+    void destroy_all() noexcept
+    {
+        if (nullptr != m_data)
+        {
+            for (INT_T prtnRead = 0; prtnRead < m_partitions.last_free().m_partitionNum; prtnRead ++)
+            {
+                INT_T const id = m_partitions.m_partitionToId[prtnRead];
+                if (id != PartitionDesc_t::smc_null)
+                {
+                    DataSpan_t const& span = m_partitions.m_idToData[id];
+                    std::destroy_n(&m_data[span.m_offset], span.m_size);
+                }
+            }
+
+            alloc_traits_t::deallocate(m_allocator, std::exchange(m_data, nullptr), m_dataSize);
+            m_dataSize = 0;
+        }
     }
 
     PartitionDesc_t m_partitions;
@@ -0,0 +1,346 @@
+/**
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: 2026 Neal Nicdao <chrisnicdao0@gmail.com>
+ */
+#pragma once
+
+#include "intarray_multimap.hpp"
+
+#include <tuple>
+
+namespace lgrn
+{
+
+/**
+ * @brief Structure-of-Arrays variant of IntArrayMultiMap. Maps IDs to multiple parallel
+ *        variable-sized arrays (columns) of different types.
+ *
+ * All columns share a single PartitionDescStl, so each partition has the same offset and size in
+ * every column. Emplacing, erasing, and packing moves all columns consistently, while each column
+ * remains its own contiguous array.
+ *
+ * Access a single column of a partition using column<N>(id).
+ */
+template<typename INT_T, typename ... COLS_T>
+class IntArrayMultiMapSoA
+{
+    static_assert(sizeof...(COLS_T) != 0, "At least one column is required");
+
+    using PartitionDesc_t   = PartitionDescStl<INT_T, std::size_t>;
+    using Utils_t           = PartitionUtils<INT_T, std::size_t>;
+
+    using NewPartition_t    = typename Utils_t::NewPartition;
+    using Free_t            = typename Utils_t::Free;
+
+    using DataSpan_t        = typename Utils_t::DataSpan;
+    using DataMoved_t       = typename PartitionDesc_t::DataMoved;
+
+    using Columns_t         = std::tuple<COLS_T*...>;
+    using Indices_t         = std::index_sequence_for<COLS_T...>;
+
+public:
+
+    template<std::size_t N>
+    using Column_t = std::tuple_element_t<N, std::tuple<COLS_T...>>;
+
+    IntArrayMultiMapSoA() = default;
+
+    IntArrayMultiMapSoA(std::size_t dataCapacity, INT_T idCapacity)
+    {
+        data_reserve(dataCapacity);
+        ids_reserve(idCapacity);
+    }
+
+    IntArrayMultiMapSoA(IntArrayMultiMapSoA const& copy) = delete;
+
+    IntArrayMultiMapSoA(IntArrayMultiMapSoA&& move) noexcept
+        : m_partitions{std::move(move.m_partitions)}
+        , m_columns{std::exchange(move.m_columns, Columns_t{})}
+        , m_dataSize{std::exchange(move.m_dataSize, 0)}
+    { }
+
+    ~IntArrayMultiMapSoA()
+    {
+        destroy_all();
+    }
+
+    IntArrayMultiMapSoA& operator=(IntArrayMultiMapSoA const& copy) = delete;
+
+    IntArrayMultiMapSoA& operator=(IntArrayMultiMapSoA&& move) noexcept
+    {
+        if (this != &move)
+        {
+            destroy_all();
+            m_partitions    = std::move(move.m_partitions);
+            m_columns       = std::exchange(move.m_columns, Columns_t{});
+            m_dataSize      = std::exchange(move.m_dataSize, 0);
+        }
+        return *this;
+    }
+
+    bool contains(INT_T id) const
+    {
+        if (! m_partitions.id_in_range(id))
+        {
+            return false;
+        }
+        return m_partitions.exists(id);
+    }
+
+    std::size_t ids_capacity() const noexcept
+    {
+        return m_partitions.m_idToData.size();
+    }
+
+    std::size_t ids_count() const noexcept
+    {
+        return m_partitions.count();
+    }
+
+    void ids_reserve(INT_T capacity)
+    {
+        m_partitions.resize(capacity);
+    }
+
+    constexpr std::size_t data_capacity() const noexcept
+    {
+        return m_dataSize;
+    }
+
+    constexpr std::size_t data_size() const noexcept
+    {
+        return m_partitions.used();
+    }
+
+    void data_reserve(std::size_t capacity)
+    {
+        LGRN_TRACE("IntArrayMultiMapSoA::data_reserve");
+        LGRN_COUNTER("IntArrayMultiMapSoA reallocations");
+
+        Columns_t newColumns{ std::allocator<COLS_T>{}.allocate(capacity)... };
+
+        Free_t &rLastFree = m_partitions.last_free();
+
+        // Move all existing partitions into the newly allocated space, removing fragmentation
+        INT_T prtnWrite = 0;
+        std::size_t writeOffset = 0;
+
+        for (INT_T prtnRead = 0; prtnRead < rLastFree.m_partitionNum; prtnRead ++)
+        {
+            INT_T const id = m_partitions.m_partitionToId[prtnRead];
+
+            // null partitions are free space
+            if (id != PartitionDesc_t::smc_null)
+            {
+                DataSpan_t &rSpan = m_partitions.m_idToData[id];
+
+                LGRN_ASSERT(writeOffset + rSpan.m_size <= capacity);
+
+                relocate(m_columns, rSpan.m_offset, newColumns, writeOffset, rSpan.m_size, Indices_t{});
+
+                if (prtnWrite != prtnRead)
+                {
+                    m_partitions.m_partitionToId[prtnRead] = PartitionDesc_t::smc_null;
+                    m_partitions.m_partitionToId[prtnWrite] = id;
+                    m_partitions.m_idToPartition[id] = prtnWrite;
+                }
+                rSpan.m_offset = writeOffset;
+
+                writeOffset += rSpan.m_size;
+                prtnWrite ++;
+            }
+        }
+
+        m_partitions.m_free.clear();
+        rLastFree.m_offset = writeOffset;
+        rLastFree.m_partitionNum = prtnWrite;
+        rLastFree.m_size = capacity - writeOffset;
+
+        deallocate(std::exchange(m_columns, newColumns), std::exchange(m_dataSize, capacity),
+                   Indices_t{});
+    }
+
+    /**
+     * @brief Create a partition and default-construct its elements in all columns
+     *
+     * @return Tuple of pointers to the first element of each column
+     */
+    Columns_t emplace(INT_T id, std::size_t size)
+    {
+        LGRN_ASSERTMV(m_partitions.id_in_range(id), "ID out of range", id, ids_capacity());
+        LGRN_ASSERTMV(!m_partitions.exists(id), "ID already exists", id);
+
+        LGRN_ASSERTMV(size <= m_partitions.last_free().m_size, "Out of data space",
+                      size, data_capacity(), data_size());
+
+        NewPartition_t const prtn = m_partitions.create(id, size);
+
+        Columns_t out = columns_at(prtn.m_offset, Indices_t{});
+        std::apply([size] (auto* ... pCols)
+        {
+            (std::uninitialized_default_construct_n(pCols, size), ...);
+        }, out);
+        return out;
+    }
+
+    void erase(INT_T id)
+    {
+        Free_t const free = m_partitions.erase(id);
+        std::apply([&free] (auto* ... pCols)
+        {
+            (std::destroy_n(pCols + free.m_offset, free.m_size), ...);
+        }, m_columns);
+    }
+
+    /**
+     * @brief Erase many IDs at once. Faster than individual erase() calls for large amounts
+     */
+    template<typename ITER_T, typename SNTL_T>
+    void erase_many(ITER_T first, SNTL_T const last)
+    {
+        for (ITER_T it = first; it != last; ++it)
+        {
+            LGRN_ASSERTMV(contains(*it), "ID does not exist", *it);
+            DataSpan_t const& span = m_partitions.m_idToData[*it];
+            std::apply([&span] (auto* ... pCols)
+            {
+                (std::destroy_n(pCols + span.m_offset, span.m_size), ...);
+            }, m_columns);
+        }
+        m_partitions.erase_many(first, last);
+    }
+
+    void pack(std::size_t maxMoveHint = ~std::size_t(0))
+    {
+        std::size_t moveTotal = 0;
+
+        while ( !m_partitions.m_free.empty() && (moveTotal < maxMoveHint) )
+        {
+            DataMoved_t const moved = m_partitions.pack_step(maxMoveHint - moveTotal);
+
+            if (moved.m_size != 0)
+            {
+                // Moving left, regions may overlap but the destination is always in front
+                relocate(m_columns, moved.m_offsetSrc, m_columns, moved.m_offsetDst, moved.m_size,
+                         Indices_t{});
+                LGRN_COUNTER_ADD("IntArrayMultiMapSoA pack moves", moved.m_size);
+                moveTotal += moved.m_size;
+            }
+        }
+    }
+
+    /**
+     * @brief Memory used by all columns and bookkeeping, and holes in the columns
+     */
+    MemoryStats memory_stats() const noexcept
+    {
+        constexpr std::size_t rowSize = (sizeof(COLS_T) + ...);
+
+        MemoryStats out = m_partitions.memory_stats(rowSize);
+        out.m_bytesReserved += m_dataSize * rowSize;
+        out.m_bytesUsed     += data_size() * rowSize;
+        return out;
+    }
+
+    /**
+     * @return Span of column N of a partition, or an empty span if the ID doesn't exist
+     */
+    template<std::size_t N>
+    Span< Column_t<N> > column(INT_T id) noexcept
+    {
+        if (!contains(id))
+        {
+            return { };
+        }
+        DataSpan_t const &span = m_partitions.m_idToData[id];
+        return {std::get<N>(m_columns) + span.m_offset, span.m_size};
+    }
+
+    template<std::size_t N>
+    Span< Column_t<N> const > column(INT_T id) const noexcept
+    {
+        if (!contains(id))
+        {
+            return { };
+        }
+        DataSpan_t const &span = m_partitions.m_idToData[id];
+        return {std::get<N>(m_columns) + span.m_offset, span.m_size};
+    }
+
+private:
+
+    template<std::size_t ... I>
+    Columns_t columns_at(std::size_t offset, std::index_sequence<I...>) const noexcept
+    {
+        return { (std::get<I>(m_columns) + offset)... };
+    }
+
+    /**
+     * @brief Move-construct elements into new locations of all columns, and destroy the old ones
+     */
+    template<std::size_t ... I>
+    static void relocate(Columns_t const& src, std::size_t srcOffset,
+                         Columns_t const& dst, std::size_t dstOffset,
+                         std::size_t size, std::index_sequence<I...>)
+    {
+        ( relocate_column(std::get<I>(src) + srcOffset, std::get<I>(dst) + dstOffset, size), ... );
+    }
+
+    template<typename COL_T>
+    static void relocate_column(COL_T* pRead, COL_T* pWrite, std::size_t size)
+    {
+        for (std::size_t i = 0; i < size; i++)
+        {
+            ::new(pWrite) COL_T(std::move(*pRead));
+            pRead->~COL_T();
+
+            pRead ++;
+            pWrite ++;
+        }
+    }
+
+    template<std::size_t ... I>
+    static void deallocate(Columns_t const& columns, std::size_t size, std::index_sequence<I...>)
+    {
+        ( impl_deallocate(std::get<I>(columns), size), ... );
+    }
+
+    template<typename COL_T>
+    static void impl_deallocate(COL_T* pData, std::size_t size)
+    {
+        if (pData != nullptr)
+        {
+            std::allocator<COL_T>{}.deallocate(pData, size);
+        }
+    }
+
+    void destroy_all() noexcept
+    {
+        if (m_dataSize == 0)
+        {
+            return;
+        }
+
+        for (INT_T prtn = 0; prtn < m_partitions.last_free().m_partitionNum; prtn ++)
+        {
+            INT_T const id = m_partitions.m_partitionToId[prtn];
+            if (id != PartitionDesc_t::smc_null)
+            {
+                DataSpan_t const& span = m_partitions.m_idToData[id];
+                std::apply([&span] (auto* ... pCols)
+                {
+                    (std::destroy_n(pCols + span.m_offset, span.m_size), ...);
+                }, m_columns);
+            }
+        }
+
+        deallocate(std::exchange(m_columns, Columns_t{}), std::exchange(m_dataSize, 0), Indices_t{});
+    }
+
+    PartitionDesc_t m_partitions;
+    Columns_t       m_columns{};
+    std::size_t     m_dataSize{0};
+
+}; // class IntArrayMultiMapSoA
+
+} // namespace lgrn
@@ -0,0 +1,168 @@
+/**
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: 2026 Neal Nicdao <chrisnicdao0@gmail.com>
+ */
+#pragma once
+
+#include "intarray_multimap.hpp"
+#include "../tasks/parallel_for.hpp"
+#include "../utility/bitmath.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace lgrn
+{
+
+/**
+ * @brief Output type of transpose(), the same container with A and B swapped
+ */
+template<typename A_T, typename B_T, typename ALLOC_T, std::size_t INLINE_N>
+using TransposedMultiMap_t = IntArrayMultiMap<
+        B_T, A_T, typename std::allocator_traits<ALLOC_T>::template rebind_alloc<A_T>, INLINE_N>;
+
+/**
+ * @brief Build the inverse relationship of an IntArrayMultiMap
+ *
+ * If src maps A -> [B...], the output maps B -> [A...]. For example, Element -> Nodes connections
+ * transposed gives Node -> Elements, or Child -> Parents gives Parent -> Children.
+ *
+ * This is a counting sort done in three passes, split into contiguous chunks of source IDs:
+ * 1. Each chunk counts occurrences of each B within its range (histogram)
+ * 2. Per-chunk write offsets are calculated using a prefix sum, and all output partitions are
+ *    created in a single data allocation
+ * 3. Each chunk scatters its A values into the output using its own offsets
+ *
+ * Output order is deterministic regardless of chunk count. Each output partition lists A in
+ * ascending order, and IDs that don't appear in src have no partition. The output uses the
+ * allocator of src rebound to A_T, and the same INLINE_N.
+ *
+ * @param src           [in] Multimap to transpose
+ * @param dstIdCapacity [in] ID capacity of the output, all values in src must be less than this
+ * @param rPool         [ref] Pool to run the histogram and scatter passes on
+ * @param chunkCount    [in] Number of chunks to split src into, 0 for one per pool thread plus
+ *                           the calling thread. Each chunk uses dstIdCapacity counters.
+ */
+template<typename A_T, typename B_T, typename ALLOC_T, std::size_t INLINE_N>
+TransposedMultiMap_t<A_T, B_T, ALLOC_T, INLINE_N> transpose(
+        IntArrayMultiMap<A_T, B_T, ALLOC_T, INLINE_N> const&    src,
+        std::size_t                                             dstIdCapacity,
+        ThreadPool&                                             rPool,
+        std::size_t                                             chunkCount = 0)
+{
+    static_assert(std::is_integral_v<A_T> && std::is_integral_v<B_T>,
+                  "transpose requires integer IDs on both sides");
+
+    if (chunkCount == 0)
+    {
+        chunkCount = std::size_t(rPool.thread_count()) + 1;
+    }
+
+    std::size_t const srcIdCapacity = src.ids_capacity();
+    std::size_t const idsPerChunk   = std::max<std::size_t>(div_ceil(srcIdCapacity, chunkCount), 1);
+    chunkCount = std::max<std::size_t>(div_ceil(srcIdCapacity, idsPerChunk), 1);
+
+    // Runs func(chunk) once for each chunk, one chunk per task
+    auto const for_each_chunk = [&rPool, chunkCount] (auto const& func)
+    {
+        parallel_for_chunks(rPool, chunkCount, 1, [&func] (std::size_t first, std::size_t last)
+        {
+            for (std::size_t chunk = first; chunk < last; ++chunk)
+            {
+                func(chunk);
+            }
+        });
+    };
+
+    auto const for_each_in_chunk = [&src, srcIdCapacity, idsPerChunk] (std::size_t chunk, auto&& func)
+    {
+        std::size_t const first = std::min(srcIdCapacity, idsPerChunk * chunk);
+        std::size_t const last  = std::min(srcIdCapacity, first + idsPerChunk);
+        for (std::size_t a = first; a < last; ++a)
+        {
+            for (B_T const b : src[A_T(a)])
+            {
+                func(A_T(a), b);
+            }
+        }
+    };
+
+    // 1. Histogram, [chunk][B] -> count
+    std::vector<std::size_t> cursors(chunkCount * dstIdCapacity, 0);
+
+    for_each_chunk([&] (std::size_t chunk)
+    {
+        std::size_t *pCounts = cursors.data() + chunk * dstIdCapacity;
+        for_each_in_chunk(chunk, [pCounts, dstIdCapacity] ([[maybe_unused]] A_T a, B_T b)
+        {
+            LGRN_ASSERTMV(std::size_t(b) < dstIdCapacity, "Value out of range", b, dstIdCapacity);
+            ++ pCounts[b];
+        });
+    });
+
+    // 2. Prefix sum over chunks for each B. Counts turn into write cursors within partitions
+    std::vector<std::size_t> totals(dstIdCapacity, 0);
+    for (std::size_t b = 0; b < dstIdCapacity; ++b)
+    {
+        std::size_t total = 0;
+        for (std::size_t chunk = 0; chunk < chunkCount; ++chunk)
+        {
+            std::size_t &rCursor = cursors[chunk * dstIdCapacity + b];
+            total += std::exchange(rCursor, total);
+        }
+        totals[b] = total;
+    }
+
+    // Only partitions too large to be stored inline take space in the data buffer. This can't
+    // be src.data_size(), which excludes src's own inline partitions.
+    std::size_t dataCapacity = 0;
+    for (std::size_t const total : totals)
+    {
+        if (total > INLINE_N)
+        {
+            dataCapacity += total;
+        }
+    }
+
+    TransposedMultiMap_t<A_T, B_T, ALLOC_T, INLINE_N> out;
+    out.ids_reserve(B_T(dstIdCapacity));
+    out.data_reserve(dataCapacity);
+
+    // Inline partitions point into the ID descriptors, which don't move after ids_reserve
+    std::vector<A_T*> partitionData(dstIdCapacity, nullptr);
+    for (std::size_t b = 0; b < dstIdCapacity; ++b)
+    {
+        if (totals[b] != 0)
+        {
+            partitionData[b] = out.emplace(B_T(b), totals[b]);
+        }
+    }
+
+    // 3. Scatter
+    for_each_chunk([&] (std::size_t chunk)
+    {
+        std::size_t *pCursors = cursors.data() + chunk * dstIdCapacity;
+        for_each_in_chunk(chunk, [pCursors, &partitionData] (A_T a, B_T b)
+        {
+            partitionData[b][pCursors[b] ++] = a;
+        });
+    });
+
+    return out;
+}
+
+/**
+ * @brief Single-threaded transpose(), runs everything on the calling thread
+ */
+template<typename A_T, typename B_T, typename ALLOC_T, std::size_t INLINE_N>
+TransposedMultiMap_t<A_T, B_T, ALLOC_T, INLINE_N> transpose(
+        IntArrayMultiMap<A_T, B_T, ALLOC_T, INLINE_N> const&    src,
+        std::size_t                                             dstIdCapacity)
+{
+    ThreadPool pool{0};
+    return transpose(src, dstIdCapacity, pool, 1);
+}
+
+} // namespace lgrn
@@ -0,0 +1,293 @@
+/**
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: 2026 Neal Nicdao <chrisnicdao0@gmail.com>
+ */
+#pragma once
+
+#include "intarray_multimap.hpp"
+
+#include <algorithm>
+#include <type_traits>
+
+namespace lgrn
+{
+
+/**
+ * @brief Non-owning IntArrayMultiMap that operates over caller-provided arrays
+ *
+ * All bookkeeping arrays, the data array, and the remaining State are supplied by the caller, and
+ * nothing is ever allocated. This allows multimaps to be placed in arenas, shared memory,
+ * GPU staging buffers, or memory-mapped files.
+ *
+ * Arrays required:
+ * * partitionToId  - Max number of partitions, including free ones. emplace() fails if all are
+ *                    used up before packing.
+ * * idToPartition  - One per ID
+ * * idToData       - One per ID
+ * * free           - Max number of free partitions (holes) that can exist before packing.
+ *                    Adjacent holes are merged, erase() fails if there's no room for a new one.
+ * * data           - Data storage, emplace() fails if there isn't enough left
+ *
+ * Call init() once on newly provided arrays. Data is required to be trivially copyable, as it's
+ * moved around with no regard to ownership.
+ */
+template<typename INT_T, typename DATA_T, typename SIZE_T = std::size_t>
+class PartitionView
+{
+    static_assert(std::is_trivially_copyable_v<DATA_T>, "PartitionView requires trivially copyable data");
+
+public:
+
+    using Utils_t       = PartitionUtils<INT_T, SIZE_T>;
+    using DataSpan_t    = typename Utils_t::DataSpan;
+    using DataMoved_t   = typename Utils_t::DataMoved;
+    using Free_t        = typename Utils_t::Free;
+
+    static constexpr INT_T const smc_null = Utils_t::smc_null;
+
+    /**
+     * @brief Remaining state that isn't stored in arrays. Trivially copyable, and can be stored
+     *        alongside the arrays.
+     */
+    struct State
+    {
+        Free_t  m_freeLast;
+        SIZE_T  m_freeCount{0};
+        SIZE_T  m_dataUsed{0};
+        SIZE_T  m_idCount{0};
+    };
+
+    constexpr PartitionView(
+            Span<INT_T>         partitionToId,
+            Span<INT_T>         idToPartition,
+            Span<DataSpan_t>    idToData,
+            Span<Free_t>        free,
+            Span<DATA_T>        data,
+            State&              rState) noexcept
+     : m_partitionToId  {partitionToId}
+     , m_idToPartition  {idToPartition}
+     , m_idToData       {idToData}
+     , m_free           {free}
+     , m_data           {data}
+     , m_pState         {&rState}
+    {
+        LGRN_ASSERTM(idToPartition.size() == idToData.size(), "ID array sizes must match");
+    }
+
+    /**
+     * @brief Initialize arrays and state to contain no partitions
+     */
+    void init() noexcept
+    {
+        std::fill(m_partitionToId.begin(), m_partitionToId.end(), smc_null);
+        std::fill(m_idToPartition.begin(), m_idToPartition.end(), smc_null);
+        std::fill(m_idToData.begin(), m_idToData.end(), DataSpan_t{0, 0});
+        *m_pState = State{};
+        m_pState->m_freeLast.m_size = SIZE_T(m_data.size());
+    }
+
+    bool contains(INT_T id) const noexcept
+    {
+        return (std::size_t(id) < m_idToPartition.size()) && (m_idToPartition[id] != smc_null);
+    }
+
+    constexpr std::size_t ids_capacity()    const noexcept { return m_idToPartition.size(); }
+    constexpr std::size_t ids_count()       const noexcept { return m_pState->m_idCount; }
+    constexpr std::size_t data_capacity()   const noexcept { return m_data.size(); }
+    constexpr std::size_t data_size()       const noexcept { return m_pState->m_dataUsed; }
+
+    /**
+     * @brief Create a partition at the end of the data array
+     *
+     * Unlike IntArrayMultiMap, the arrays can't grow, so running out of space is not an error.
+     *
+     * @return Pointer to uninitialized data for the new partition, or nullptr if there isn't
+     *         enough data space after the last partition, or no partition numbers left. Nothing
+     *         is changed in that case; pack() may make room.
+     */
+    DATA_T* emplace(INT_T id, std::size_t size) noexcept
+    {
+        LGRN_ASSERTMV(std::size_t(id) < ids_capacity(), "ID out of range", id, ids_capacity());
+        LGRN_ASSERTMV(!contains(id), "ID already exists", id);
+
+        Free_t &rLastFree = m_pState->m_freeLast;
+        if (   size > std::size_t(rLastFree.m_size)
+            || std::size_t(rLastFree.m_partitionNum) >= m_partitionToId.size())
+        {
+            return nullptr;
+        }
+
+        auto const prtn = Utils_t::create_partition(SIZE_T(size), rLastFree);
+        m_partitionToId[prtn.m_partitionNum]    = id;
+        m_idToPartition[id]                     = prtn.m_partitionNum;
+        m_idToData[id]                          = DataSpan_t{prtn.m_offset, SIZE_T(size)};
+
+        m_pState->m_idCount ++;
+        m_pState->m_dataUsed += size;
+        return &m_data[prtn.m_offset];
+    }
+
+    /**
+     * @return Pointer to the new partition's data, or nullptr if there's no room, see above
+     */
+    template<typename IT_T>
+    DATA_T* emplace(INT_T id, IT_T first, IT_T last) noexcept
+    {
+        DATA_T* const pData = emplace(id, std::size_t(std::distance(first, last)));
+        if (pData != nullptr)
+        {
+            std::copy(first, last, pData);
+        }
+        return pData;
+    }
+
+    DATA_T* emplace(INT_T id, std::initializer_list<DATA_T> list) noexcept
+    {
+        return emplace(id, std::begin(list), std::end(list));
+    }
+
+    /**
+     * @brief Erase a partition, merging it with adjacent free partitions
+     *
+     * The free list only grows if the erased partition has no free neighbours. Finding neighbours
+     * is O(log n) of the number of free partitions; merging both neighbours or adding a new free
+     * partition shifts the free list, O(n).
+     *
+     * @return false if the free list is full and the partition can't be merged, call pack() and
+     *         try again. Nothing is changed.
+     */
+    bool erase(INT_T id) noexcept
+    {
+        LGRN_ASSERTMV(contains(id), "ID does not exist", id);
+
+        INT_T const partition = m_idToPartition[id];
+
+        // Free list is sorted in descending partition number, back is the first free partition.
+        // Right neighbour is before pSplit, left neighbour is at pSplit.
+        Free_t* const pFirst = m_free.data();
+        Free_t* const pLast  = pFirst + m_pState->m_freeCount;
+        Free_t* const pSplit = std::upper_bound(pFirst, pLast, partition,
+                [] (INT_T const lhs, Free_t const& rhs) -> bool
+        {
+            return lhs > rhs.m_partitionNum;
+        });
+        Free_t* const pLeft  = (pSplit != pLast)  ? pSplit       : nullptr;
+        Free_t* const pRight = (pSplit != pFirst) ? pSplit - 1   : nullptr;
+
+        auto const [mergeLeft, mergeRight, mergeLast]
+                = Utils_t::erase_neighbors(pLeft, pRight, m_pState->m_freeLast, partition);
+
+        if ( ! (mergeLeft || mergeRight || mergeLast) && m_pState->m_freeCount == m_free.size() )
+        {
+            return false;
+        }
+
+        m_idToPartition[id] = smc_null;
+        m_partitionToId[partition] = smc_null;
+        DataSpan_t const data = std::exchange(m_idToData[id], DataSpan_t{0, 0});
+        Free_t const erased{data.m_offset, partition, 1, data.m_size};
+
+        // Remove a free partition from the list, keeping order
+        auto const remove = [this, pLast] (Free_t* pFree) noexcept
+        {
+            std::move(pFree + 1, pLast, pFree);
+            m_pState->m_freeCount --;
+        };
+
+        if (mergeLeft)
+        {
+            pLeft->m_partitionCount += 1;
+            pLeft->m_size           += data.m_size;
+
+            if (mergeRight)
+            {
+                // Right absorbs left, so only entries after left need to shift
+                pRight->m_offset         = pLeft->m_offset;
+                pRight->m_partitionNum   = pLeft->m_partitionNum;
+                pRight->m_partitionCount += pLeft->m_partitionCount;
+                pRight->m_size           += pLeft->m_size;
+                remove(pLeft);
+            }
+            else if (mergeLast)
+            {
+                Utils_t::absorb_into_last(m_pState->m_freeLast, *pLeft);
+                remove(pLeft);
+            }
+        }
+        else if (mergeRight)
+        {
+            // Grow right free partition left, its order doesn't change
+            pRight->m_offset         = data.m_offset;
+            pRight->m_partitionNum   = partition;
+            pRight->m_partitionCount += 1;
+            pRight->m_size           += data.m_size;
+        }
+        else if (mergeLast)
+        {
+            Utils_t::absorb_into_last(m_pState->m_freeLast, erased);
+        }
+        else
+        {
+            std::move_backward(pSplit, pLast, pLast + 1);
+            *pSplit = erased;
+            m_pState->m_freeCount ++;
+        }
+
+        m_pState->m_dataUsed -= data.m_size;
+        m_pState->m_idCount --;
+        return true;
+    }
+
+    void pack(std::size_t maxMoveHint = ~std::size_t(0)) noexcept
+    {
+        std::size_t moveTotal = 0;
+
+        while ( (m_pState->m_freeCount != 0) && (moveTotal < maxMoveHint) )
+        {
+            SIZE_T const freeCount = m_pState->m_freeCount;
+            Free_t &rFirst = m_free[freeCount - 1];
+            Free_t &rNext  = (freeCount == 1) ? m_pState->m_freeLast : m_free[freeCount - 2];
+
+            bool firstMerged = false;
+            DataMoved_t const moved = Utils_t::pack_step(
+                    rFirst, rNext, firstMerged, m_partitionToId, m_partitionToId.size(),
+                    m_idToPartition, m_idToData, SIZE_T(maxMoveHint - moveTotal));
+
+            if (firstMerged)
+            {
+                m_pState->m_freeCount --;
+            }
+
+            if (moved.m_size != 0)
+            {
+                // Moving left, regions may overlap
+                std::copy_n(&m_data[moved.m_offsetSrc], moved.m_size, &m_data[moved.m_offsetDst]);
+                moveTotal += moved.m_size;
+            }
+        }
+    }
+
+    Span<DATA_T> operator[] (INT_T id) const noexcept
+    {
+        if (!contains(id))
+        {
+            return { };
+        }
+        DataSpan_t const &span = m_idToData[id];
+        return {&m_data[span.m_offset], span.m_size};
+    }
+
+    constexpr State const& state() const noexcept { return *m_pState; }
+
+private:
+
+    Span<INT_T>         m_partitionToId;
+    Span<INT_T>         m_idToPartition;
+    Span<DataSpan_t>    m_idToData;
+    Span<Free_t>        m_free;
+    Span<DATA_T>        m_data;
+    State               *m_pState;
+
+}; // class PartitionView
+
+} // namespace lgrn
@@ -9,6 +9,7 @@
 
 #include "../utility/enum_traits.hpp"
 #include "../utility/asserts.hpp"
+#include "../utility/trace.hpp"
 
 namespace lgrn
 {
@@ -70,7 +71,7 @@ public:
      */
     void remove(ID_T id) noexcept
     {
-        LGRN_ASSERTMV(exists(id), "ID does not exist", std::size_t(id));
+        LGRN_ASSERTMV_CHEAP(exists(id), "ID does not exist", std::size_t(id));
         Base_t::set(id_int_t(id));
     }
 
@@ -102,6 +103,11 @@ ITER_T BitViewIdRegistry<BITVIEW_T, ID_T>::create(ITER_T first, SNTL_T last)
     auto       onesFirst = ones.begin();
     auto const &onesLast = ones.end();
 
+    // Full words skipped before finding a free ID
+    LGRN_COUNTER("BitViewIdRegistry::create calls");
+    LGRN_COUNTER_ADD("BitViewIdRegistry::create words skipped",
+                     (onesFirst != onesLast) ? (*onesFirst / Base_t::int_bitsize()) : Base_t::ints().size());
+
     while ( (first != last) && (onesFirst != onesLast) )
     {
         std::size_t const pos = *onesFirst;
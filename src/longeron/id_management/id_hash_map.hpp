@@ -0,0 +1,339 @@
+/**
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: 2026 Neal Nicdao <chrisnicdao0@gmail.com>
+ */
+#pragma once
+
+#include "null.hpp"
+
+#include "../containers/intarray_multimap.hpp" // for Span
+#include "../utility/asserts.hpp"
+#include "../utility/bitmath.hpp"
+#include "../utility/enum_traits.hpp"
+#include "../utility/memory_stats.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace lgrn
+{
+
+/**
+ * @brief Hash map keyed by IDs, for when IDs are too sparse for a KeyedVec
+ *
+ * Keys and values are stored densely in insertion order (until erased), so iterating is as fast
+ * as iterating a vector; see keys() and values(). The hash table only stores keys and dense
+ * indices, and uses open addressing with Robin Hood linear probing. id_null is used to mark empty
+ * slots, so it can't be used as a key.
+ *
+ * Erasing swaps the last dense element into the erased one's place, and removes the slot with
+ * backward-shift deletion, so there are no tombstones.
+ *
+ * Pointers and references to values are invalidated by insertions and erasures.
+ */
+template<typename ID_T, typename VALUE_T>
+class IdHashMap
+{
+    using id_int_t = underlying_int_type_t<ID_T>;
+
+    struct Slot
+    {
+        ID_T            m_key;
+        std::uint32_t   m_dense;
+    };
+
+public:
+
+    std::size_t size() const noexcept { return m_keys.size(); }
+    bool empty() const noexcept { return m_keys.empty(); }
+
+    /**
+     * @brief Allocate enough to hold n elements without rehashing
+     */
+    void reserve(std::size_t n)
+    {
+        m_keys.reserve(n);
+        m_values.reserve(n);
+        std::size_t const slotsNeeded = slot_count_for(n);
+        if (slotsNeeded > m_slots.size())
+        {
+            rehash(slotsNeeded);
+        }
+    }
+
+    bool contains(ID_T const key) const noexcept
+    {
+        return find_slot(key) != smc_notFound;
+    }
+
+    /**
+     * @return Pointer to a value, or nullptr if not found
+     */
+    VALUE_T* find(ID_T const key) noexcept
+    {
+        std::size_t const slot = find_slot(key);
+        return (slot == smc_notFound) ? nullptr : &m_values[m_slots[slot].m_dense];
+    }
+
+    VALUE_T const* find(ID_T const key) const noexcept
+    {
+        std::size_t const slot = find_slot(key);
+        return (slot == smc_notFound) ? nullptr : &m_values[m_slots[slot].m_dense];
+    }
+
+    VALUE_T& at(ID_T const key) noexcept
+    {
+        VALUE_T *pValue = find(key);
+        LGRN_ASSERTMV(pValue != nullptr, "Key not found", std::size_t(key));
+        return *pValue;
+    }
+
+    VALUE_T const& at(ID_T const key) const noexcept
+    {
+        VALUE_T const *pValue = find(key);
+        LGRN_ASSERTMV(pValue != nullptr, "Key not found", std::size_t(key));
+        return *pValue;
+    }
+
+    /**
+     * @brief Access a value, default-constructing it if it doesn't exist
+     */
+    VALUE_T& operator[](ID_T const key)
+    {
+        return emplace(key).first;
+    }
+
+    /**
+     * @brief Insert a value if the key doesn't exist
+     *
+     * @return Reference to the value, and true if it was inserted
+     */
+    template<typename ... ARGS_T>
+    std::pair<VALUE_T&, bool> emplace(ID_T const key, ARGS_T&& ... args)
+    {
+        LGRN_ASSERTM(key != id_null<ID_T>(), "id_null can't be used as a key");
+
+        std::size_t const existing = find_slot(key);
+        if (existing != smc_notFound)
+        {
+            return {m_values[m_slots[existing].m_dense], false};
+        }
+
+        if (slot_count_for(m_keys.size() + 1) > m_slots.size())
+        {
+            rehash(std::max<std::size_t>(slot_count_for(m_keys.size() + 1), m_slots.size() * 2));
+        }
+
+        std::uint32_t const dense = std::uint32_t(m_keys.size());
+        m_values.emplace_back(std::forward<ARGS_T>(args)...);
+        m_keys.push_back(key);
+        insert_slot(Slot{key, dense});
+        return {m_values.back(), true};
+    }
+
+    /**
+     * @brief Insert a value, or overwrite it if the key already exists
+     */
+    template<typename T>
+    VALUE_T& insert_or_assign(ID_T const key, T&& value)
+    {
+        auto [rValue, inserted] = emplace(key, std::forward<T>(value));
+        if ( ! inserted )
+        {
+            rValue = std::forward<T>(value);
+        }
+        return rValue;
+    }
+
+    /**
+     * @return true if the key existed and was erased
+     */
+    bool erase(ID_T const key) noexcept
+    {
+        std::size_t hole = find_slot(key);
+        if (hole == smc_notFound)
+        {
+            return false;
+        }
+
+        std::uint32_t const dense = m_slots[hole].m_dense;
+
+        // Backward-shift deletion, pull following slots back until an empty slot or a slot that's
+        // already in its ideal position
+        std::size_t const mask = m_slots.size() - 1;
+        std::size_t next = (hole + 1) & mask;
+        while (m_slots[next].m_key != id_null<ID_T>() && probe_distance(next) != 0)
+        {
+            m_slots[hole] = m_slots[next];
+            hole = next;
+            next = (next + 1) & mask;
+        }
+        m_slots[hole].m_key = id_null<ID_T>();
+
+        // Move last dense element into the erased one's place
+        std::uint32_t const last = std::uint32_t(m_keys.size() - 1);
+        if (dense != last)
+        {
+            m_keys[dense]   = m_keys[last];
+            m_values[dense] = std::move(m_values[last]);
+            m_slots[find_slot(m_keys[dense])].m_dense = dense;
+        }
+        m_keys.pop_back();
+        m_values.pop_back();
+        return true;
+    }
+
+    void clear() noexcept
+    {
+        for (Slot &rSlot : m_slots)
+        {
+            rSlot.m_key = id_null<ID_T>();
+        }
+        m_keys.clear();
+        m_values.clear();
+    }
+
+    /**
+     * @return All keys, in the same order as values()
+     */
+    Span<ID_T const> keys() const noexcept { return {m_keys.data(), m_keys.size()}; }
+
+    Span<VALUE_T>       values()       noexcept { return {m_values.data(), m_values.size()}; }
+    Span<VALUE_T const> values() const noexcept { return {m_values.data(), m_values.size()}; }
+
+    /**
+     * @brief Call a function for each element as func(ID_T key, VALUE_T& value)
+     */
+    template<typename FUNC_T>
+    void for_each(FUNC_T&& func)
+    {
+        for (std::size_t i = 0; i < m_keys.size(); ++i)
+        {
+            func(m_keys[i], m_values[i]);
+        }
+    }
+
+    template<typename FUNC_T>
+    void for_each(FUNC_T&& func) const
+    {
+        for (std::size_t i = 0; i < m_keys.size(); ++i)
+        {
+            func(m_keys[i], m_values[i]);
+        }
+    }
+
+    MemoryStats memory_stats() const noexcept
+    {
+        MemoryStats out = sum_memory_stats(m_keys, m_values, m_slots);
+        out.m_bytesUsed -= (m_slots.size() - m_keys.size()) * sizeof(Slot);
+        return out;
+    }
+
+private:
+
+    static constexpr std::size_t smc_notFound = ~std::size_t(0);
+
+    /**
+     * @return Power-of-two slot count that keeps load factor at or under 7/8
+     */
+    static std::size_t slot_count_for(std::size_t n) noexcept
+    {
+        if (n == 0)
+        {
+            return 0;
+        }
+        std::size_t out = 8;
+        while (out * 7 / 8 < n)
+        {
+            out *= 2;
+        }
+        return out;
+    }
+
+    /**
+     * @brief Fibonacci hashing, good at spreading sequential IDs
+     */
+    std::size_t ideal_slot(ID_T const key) const noexcept
+    {
+        std::uint64_t const hash = std::uint64_t(id_int_t(key)) * 0x9E3779B97F4A7C15ull;
+        return std::size_t(hash >> m_hashShift);
+    }
+
+    std::size_t probe_distance(std::size_t slot) const noexcept
+    {
+        return (slot - ideal_slot(m_slots[slot].m_key)) & (m_slots.size() - 1);
+    }
+
+    std::size_t find_slot(ID_T const key) const noexcept
+    {
+        if (m_keys.empty())
+        {
+            return smc_notFound;
+        }
+
+        std::size_t const mask = m_slots.size() - 1;
+        std::size_t slot = ideal_slot(key);
+        for (std::size_t dist = 0; ; ++dist)
+        {
+            ID_T const slotKey = m_slots[slot].m_key;
+            if (slotKey == key)
+            {
+                return slot;
+            }
+
+            // Robin Hood invariant: the key would have displaced any slot that's closer to its
+            // ideal position than we are
+            if (slotKey == id_null<ID_T>() || probe_distance(slot) < dist)
+            {
+                return smc_notFound;
+            }
+            slot = (slot + 1) & mask;
+        }
+    }
+
+    void insert_slot(Slot slot) noexcept
+    {
+        std::size_t const mask = m_slots.size() - 1;
+        std::size_t pos = ideal_slot(slot.m_key);
+        for (std::size_t dist = 0; ; ++dist)
+        {
+            if (m_slots[pos].m_key == id_null<ID_T>())
+            {
+                m_slots[pos] = slot;
+                return;
+            }
+
+            // Take from the rich (close to ideal), give to the poor (far from ideal)
+            std::size_t const existingDist = probe_distance(pos);
+            if (existingDist < dist)
+            {
+                std::swap(slot, m_slots[pos]);
+                dist = existingDist;
+            }
+            pos = (pos + 1) & mask;
+        }
+    }
+
+    void rehash(std::size_t slotCount)
+    {
+        LGRN_ASSERTM((slotCount & (slotCount - 1)) == 0, "Slot count must be a power of two");
+
+        m_slots.assign(slotCount, Slot{id_null<ID_T>(), 0});
+        m_hashShift = 64 - ctz(std::uint64_t(slotCount));
+        for (std::uint32_t i = 0; i < m_keys.size(); ++i)
+        {
+            insert_slot(Slot{m_keys[i], i});
+        }
+    }
+
+    std::vector<ID_T>       m_keys;
+    std::vector<VALUE_T>    m_values;
+
+    std::vector<Slot>       m_slots;
+    int                     m_hashShift{64};
+
+}; // class IdHashMap
+
+} // namespace lgrn
@@ -0,0 +1,565 @@
+/**
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: 2026 Neal Nicdao <chrisnicdao0@gmail.com>
+ */
+#pragma once
+
+#include "keyed_vec_stl.hpp"
+#include "null.hpp"
+
+#include "../utility/asserts.hpp"
+#include "../utility/enum_traits.hpp"
+#include "../utility/memory_stats.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace lgrn
+{
+
+/**
+ * @brief Array layouts and lookup shared by IdNameTable and IdNameTableView
+ *
+ * A table is made of 3 arrays:
+ * * Slots   - Open-addressing hash table of (hash, ID). Power-of-two size, empty if ID is null
+ * * Entries - [ID] -> (offset, size) of the ID's name in the arena
+ * * Arena   - All names, one after the other, not null-terminated
+ */
+template<typename ID_T>
+struct IdNameTableLayout
+{
+    using id_int_t = underlying_int_type_t<ID_T>;
+
+    struct Slot
+    {
+        std::uint32_t   m_hash;
+        id_int_t        m_id;
+    };
+
+    struct Entry
+    {
+        std::uint32_t   m_offset;
+        std::uint32_t   m_size;
+    };
+
+    static constexpr id_int_t      const smc_emptySlot  = id_int_t(id_null<ID_T>());
+    static constexpr std::uint32_t const smc_noName     = 0xFFFFFFFFu;
+
+    /**
+     * @brief Serialized header, followed by slots, entries, then the arena
+     */
+    struct Header
+    {
+        std::uint32_t   m_magic;
+        std::uint32_t   m_idIntSize;
+        std::uint64_t   m_slotCount;
+        std::uint64_t   m_entryCount;
+        std::uint64_t   m_arenaSize;
+    };
+
+    static constexpr std::uint32_t const smc_magic = 0x4C4E4D54u; // "LNMT"
+
+    static_assert(sizeof(Header) % alignof(Slot) == 0);
+    static_assert(sizeof(Slot) % alignof(Entry) == 0);
+
+    /**
+     * @brief 32-bit FNV-1a
+     */
+    static constexpr std::uint32_t hash(std::string_view str) noexcept
+    {
+        std::uint32_t out = 2166136261u;
+        for (char const c : str)
+        {
+            out = (out ^ std::uint8_t(c)) * 16777619u;
+        }
+        return out;
+    }
+
+    static std::string_view name(Entry const* pEntries, std::size_t entryCount, char const* pArena, ID_T id) noexcept
+    {
+        if (std::size_t(id) >= entryCount)
+        {
+            return {};
+        }
+        Entry const entry = pEntries[std::size_t(id)];
+        return (entry.m_offset == smc_noName) ? std::string_view{}
+                                               : std::string_view{pArena + entry.m_offset, entry.m_size};
+    }
+
+    /**
+     * @return Slot index containing the name, or the empty slot where it would be inserted
+     */
+    static std::size_t find_slot(
+            Slot const* pSlots, std::size_t slotCount, Entry const* pEntries, char const* pArena,
+            std::string_view str, std::uint32_t strHash) noexcept
+    {
+        std::size_t const mask = slotCount - 1;
+        std::size_t i = strHash & mask;
+        while (true)
+        {
+            Slot const &slot = pSlots[i];
+            if (slot.m_id == smc_emptySlot)
+            {
+                return i;
+            }
+            if (slot.m_hash == strHash)
+            {
+                Entry const entry = pEntries[std::size_t(slot.m_id)];
+                if (entry.m_size == str.size()
+                    && std::memcmp(pArena + entry.m_offset, str.data(), str.size()) == 0)
+                {
+                    return i;
+                }
+            }
+            i = (i + 1) & mask;
+        }
+    }
+
+    /**
+     * @brief Check if a serialized blob is safe to read
+     *
+     * Sizes must fit in the blob without overflowing, the slot count must be zero or a power of
+     * two with at least one empty slot (so probing terminates), and all slots and entries must
+     * refer to valid entries and arena ranges. Every named entry must be in exactly one slot,
+     * reachable by probing from the hash of its name, and no other slots may be occupied.
+     *
+     * O(n) for tables written by IdNameTable::serialize, as each name is found within a few
+     * probes. Nothing is allocated.
+     */
+    static bool validate(void const* pBlob, std::size_t size) noexcept
+    {
+        if (size < sizeof(Header))
+        {
+            return false;
+        }
+
+        auto const *pBytes = static_cast<std::byte const*>(pBlob);
+        Header header;
+        std::memcpy(&header, pBytes, sizeof(Header));
+
+        if (   header.m_magic != smc_magic
+            || header.m_idIntSize != sizeof(id_int_t)
+            || (header.m_slotCount & (header.m_slotCount - 1)) != 0)
+        {
+            return false;
+        }
+
+        // expectSize = header + slots + entries + arena, checking for overflow each step
+        std::uint64_t const available = size - sizeof(Header);
+        std::uint64_t expectSize = 0;
+        auto const add_checked = [&expectSize, available] (std::uint64_t count, std::uint64_t elemSize) noexcept
+        {
+            if (count > (available - expectSize) / elemSize)
+            {
+                return false;
+            }
+            expectSize += count * elemSize;
+            return true;
+        };
+        if (   ! add_checked(header.m_slotCount,  sizeof(Slot))
+            || ! add_checked(header.m_entryCount, sizeof(Entry))
+            || ! add_checked(header.m_arenaSize,  1) )
+        {
+            return false;
+        }
+
+        pBytes += sizeof(Header);
+        auto const *pSlots   = reinterpret_cast<Slot const*>(pBytes);
+        auto const *pEntries = reinterpret_cast<Entry const*>(pBytes + header.m_slotCount * sizeof(Slot));
+
+        std::uint64_t namedCount = 0;
+        for (std::uint64_t i = 0; i < header.m_entryCount; ++i)
+        {
+            Entry const entry = pEntries[i];
+            if (entry.m_offset == smc_noName)
+            {
+                continue;
+            }
+            if (entry.m_offset > header.m_arenaSize || entry.m_size > header.m_arenaSize - entry.m_offset)
+            {
+                return false;
+            }
+            ++ namedCount;
+        }
+
+        std::uint64_t occupiedCount = 0;
+        for (std::uint64_t i = 0; i < header.m_slotCount; ++i)
+        {
+            Slot const slot = pSlots[i];
+            if (slot.m_id == smc_emptySlot)
+            {
+                continue;
+            }
+            if (   std::uint64_t(slot.m_id) >= header.m_entryCount
+                || pEntries[std::size_t(slot.m_id)].m_offset == smc_noName)
+            {
+                return false;
+            }
+            ++ occupiedCount;
+        }
+
+        // Leaves at least one empty slot. Zero slots are only allowed if there are no names.
+        if (   occupiedCount != namedCount
+            || (namedCount != 0 && namedCount >= header.m_slotCount))
+        {
+            return false;
+        }
+
+        // Each named entry must be found in a slot holding its ID. Found slots are all distinct,
+        // and there are exactly as many occupied slots as names, so no ID can be in two slots.
+        auto const *pArena = reinterpret_cast<char const*>(
+                pBytes + header.m_slotCount * sizeof(Slot) + header.m_entryCount * sizeof(Entry));
+        std::size_t const mask = std::size_t(header.m_slotCount) - 1;
+        for (std::uint64_t id = 0; id < header.m_entryCount && namedCount != 0; ++id)
+        {
+            Entry const entry = pEntries[id];
+            if (entry.m_offset == smc_noName)
+            {
+                continue;
+            }
+            std::uint32_t const nameHash = hash({pArena + entry.m_offset, entry.m_size});
+            std::size_t i = nameHash & mask;
+            while (pSlots[i].m_id != id_int_t(id) || pSlots[i].m_hash != nameHash)
+            {
+                if (pSlots[i].m_id == smc_emptySlot)
+                {
+                    return false;
+                }
+                i = (i + 1) & mask;
+            }
+        }
+
+        return true;
+    }
+
+    static ID_T find(
+            Slot const* pSlots, std::size_t slotCount, Entry const* pEntries, char const* pArena,
+            std::string_view str) noexcept
+    {
+        if (slotCount == 0)
+        {
+            return id_null<ID_T>();
+        }
+        return ID_T(pSlots[find_slot(pSlots, slotCount, pEntries, pArena, str, hash(str))].m_id);
+    }
+};
+
+/**
+ * @brief Read-only IdNameTable over a serialized blob, eg: a memory-mapped file
+ *
+ * Nothing is copied. The blob must outlive the view, and be aligned to at least 8 bytes.
+ */
+template<typename ID_T>
+class IdNameTableView
+{
+    using Layout_t = IdNameTableLayout<ID_T>;
+    using Header_t = typename Layout_t::Header;
+    using Slot_t   = typename Layout_t::Slot;
+    using Entry_t  = typename Layout_t::Entry;
+
+public:
+
+    IdNameTableView() = default;
+
+    /**
+     * @brief Attach to a blob written by IdNameTable::serialize
+     *
+     * The entire blob is validated first, see IdNameTableLayout::validate. This is O(n).
+     *
+     * @return false if the blob is invalid, and the view is unchanged
+     */
+    bool attach(void const* pBlob, std::size_t size) noexcept
+    {
+        if ( ! Layout_t::validate(pBlob, size) )
+        {
+            return false;
+        }
+
+        auto const *pBytes = static_cast<std::byte const*>(pBlob);
+        Header_t header;
+        std::memcpy(&header, pBytes, sizeof(Header_t));
+
+        pBytes      += sizeof(Header_t);
+        m_pSlots    = reinterpret_cast<Slot_t const*>(pBytes);
+        pBytes      += header.m_slotCount * sizeof(Slot_t);
+        m_pEntries  = reinterpret_cast<Entry_t const*>(pBytes);
+        pBytes      += header.m_entryCount * sizeof(Entry_t);
+        m_pArena    = reinterpret_cast<char const*>(pBytes);
+
+        m_slotCount  = header.m_slotCount;
+        m_entryCount = header.m_entryCount;
+        return true;
+    }
+
+    /**
+     * @return ID with a name, or id_null if not found
+     */
+    ID_T find(std::string_view str) const noexcept
+    {
+        return Layout_t::find(m_pSlots, m_slotCount, m_pEntries, m_pArena, str);
+    }
+
+    /**
+     * @return Name of an ID, or empty if it has no name
+     */
+    std::string_view name(ID_T id) const noexcept
+    {
+        return Layout_t::name(m_pEntries, m_entryCount, m_pArena, id);
+    }
+
+private:
+    Slot_t const    *m_pSlots{nullptr};
+    Entry_t const   *m_pEntries{nullptr};
+    char const      *m_pArena{nullptr};
+    std::size_t     m_slotCount{0};
+    std::size_t     m_entryCount{0};
+};
+
+/**
+ * @brief Two-way mapping between IDs and unique names, with all names stored in one arena
+ *
+ * Compared to std::map<std::string, Id>, there are no per-name allocations, and lookups are a
+ * hash and (usually) a single string compare. Names of removed IDs stay in the arena until the
+ * table is cleared.
+ *
+ * The whole table can be written to a single blob with serialize(), and loaded back with
+ * deserialize() or used in-place with IdNameTableView.
+ *
+ * No automatic reallocations for IDs. Use \c ids_reserve();
+ */
+template<typename ID_T>
+class IdNameTable
+{
+    using Layout_t = IdNameTableLayout<ID_T>;
+    using Header_t = typename Layout_t::Header;
+    using Slot_t   = typename Layout_t::Slot;
+    using Entry_t  = typename Layout_t::Entry;
+
+public:
+
+    void ids_reserve(std::size_t n)
+    {
+        m_entries.resize(n, Entry_t{Layout_t::smc_noName, 0});
+    }
+
+    std::size_t ids_capacity() const noexcept { return m_entries.size(); }
+
+    /**
+     * @return Number of IDs with names
+     */
+    std::size_t size() const noexcept { return m_count; }
+
+    /**
+     * @brief Give an ID a name
+     *
+     * @return false if the name is already used by a different ID, nothing is changed
+     */
+    bool assign(ID_T id, std::string_view str)
+    {
+        LGRN_ASSERTMV(std::size_t(id) < m_entries.size(), "ID out of range, use ids_reserve",
+                      std::size_t(id), m_entries.size());
+
+        // Keep load factor under 1/2
+        if ((m_count + 1) * 2 > m_slots.size())
+        {
+            rehash(std::max<std::size_t>(16, m_slots.size() * 2));
+        }
+
+        std::uint32_t const strHash = Layout_t::hash(str);
+        std::size_t const slot = Layout_t::find_slot(m_slots.data(), m_slots.size(), m_entries.data(),
+                                                     m_arena.data(), str, strHash);
+        if (m_slots[slot].m_id != Layout_t::smc_emptySlot)
+        {
+            return ID_T(m_slots[slot].m_id) == id;
+        }
+
+        if (m_entries[id].m_offset != Layout_t::smc_noName)
+        {
+            erase(id);
+            assign(id, str);
+            return true;
+        }
+
+        LGRN_ASSERTM(m_arena.size() + str.size() < Layout_t::smc_noName, "Arena full");
+        m_entries[id] = Entry_t{std::uint32_t(m_arena.size()), std::uint32_t(str.size())};
+        m_arena.insert(m_arena.end(), str.begin(), str.end());
+        m_slots[slot] = Slot_t{strHash, typename Layout_t::id_int_t(id)};
+        ++ m_count;
+        return true;
+    }
+
+    /**
+     * @return ID with a name, or id_null if not found
+     */
+    ID_T find(std::string_view str) const noexcept
+    {
+        return Layout_t::find(m_slots.data(), m_slots.size(), m_entries.data(), m_arena.data(), str);
+    }
+
+    /**
+     * @return Name of an ID, or empty if it has no name
+     */
+    std::string_view name(ID_T id) const noexcept
+    {
+        return Layout_t::name(m_entries.data(), m_entries.size(), m_arena.data(), id);
+    }
+
+    bool contains(ID_T id) const noexcept
+    {
+        return std::size_t(id) < m_entries.size() && m_entries[id].m_offset != Layout_t::smc_noName;
+    }
+
+    /**
+     * @brief Remove the name of an ID, if it has one
+     */
+    void erase(ID_T id) noexcept
+    {
+        if ( ! contains(id) )
+        {
+            return;
+        }
+
+        std::string_view const str = name(id);
+        std::size_t const mask = m_slots.size() - 1;
+        std::size_t hole = Layout_t::find_slot(m_slots.data(), m_slots.size(), m_entries.data(),
+                                               m_arena.data(), str, Layout_t::hash(str));
+
+        // Backward-shift deletion: pull following entries of the cluster into the hole if their
+        // ideal slot isn't between the hole and themselves
+        std::size_t i = (hole + 1) & mask;
+        while (m_slots[i].m_id != Layout_t::smc_emptySlot)
+        {
+            std::size_t const ideal = m_slots[i].m_hash & mask;
+            if (((i - ideal) & mask) >= ((i - hole) & mask))
+            {
+                m_slots[hole] = m_slots[i];
+                hole = i;
+            }
+            i = (i + 1) & mask;
+        }
+        m_slots[hole].m_id = Layout_t::smc_emptySlot;
+
+        m_entries[id] = Entry_t{Layout_t::smc_noName, 0};
+        -- m_count;
+    }
+
+    /**
+     * @brief Remove all names and free up the arena, keeping ID capacity
+     */
+    void clear() noexcept
+    {
+        std::fill(m_entries.begin(), m_entries.end(), Entry_t{Layout_t::smc_noName, 0});
+        std::fill(m_slots.begin(), m_slots.end(), Slot_t{0, Layout_t::smc_emptySlot});
+        m_arena.clear();
+        m_count = 0;
+    }
+
+    /**
+     * @brief Write the entire table into a single blob, readable by deserialize or IdNameTableView
+     */
+    std::vector<std::byte> serialize() const
+    {
+        Header_t const header{
+            Layout_t::smc_magic, sizeof(typename Layout_t::id_int_t),
+            m_slots.size(), m_entries.size(), m_arena.size() };
+
+        std::vector<std::byte> out(sizeof(Header_t)
+                                   + m_slots.size()   * sizeof(Slot_t)
+                                   + m_entries.size() * sizeof(Entry_t)
+                                   + m_arena.size());
+        std::byte *pOut = out.data();
+        pOut = write_bytes(pOut, &header, sizeof(Header_t));
+        pOut = write_bytes(pOut, m_slots.data(),   m_slots.size()   * sizeof(Slot_t));
+        pOut = write_bytes(pOut, m_entries.data(), m_entries.size() * sizeof(Entry_t));
+        write_bytes(pOut, m_arena.data(), m_arena.size());
+        return out;
+    }
+
+    /**
+     * @brief Replace contents with a blob written by serialize
+     *
+     * @return false if the blob is invalid, nothing is changed
+     */
+    bool deserialize(void const* pBlob, std::size_t size)
+    {
+        if ( ! Layout_t::validate(pBlob, size) )
+        {
+            return false;
+        }
+
+        Header_t header;
+        std::memcpy(&header, pBlob, sizeof(Header_t));
+        auto const *pBytes = static_cast<std::byte const*>(pBlob) + sizeof(Header_t);
+
+        m_slots.resize(header.m_slotCount);
+        std::memcpy(m_slots.data(), pBytes, header.m_slotCount * sizeof(Slot_t));
+        pBytes += header.m_slotCount * sizeof(Slot_t);
+
+        m_entries.resize(header.m_entryCount);
+        std::memcpy(m_entries.data(), pBytes, header.m_entryCount * sizeof(Entry_t));
+        pBytes += header.m_entryCount * sizeof(Entry_t);
+
+        m_arena.resize(header.m_arenaSize);
+        std::memcpy(m_arena.data(), pBytes, header.m_arenaSize);
+
+        m_count = std::size_t(std::count_if(m_entries.begin(), m_entries.end(), [] (Entry_t const& entry)
+        {
+            return entry.m_offset != Layout_t::smc_noName;
+        }));
+        return true;
+    }
+
+    MemoryStats memory_stats() const noexcept
+    {
+        MemoryStats out = sum_memory_stats(m_slots, m_entries, m_arena);
+
+        // Only count occupied slots and named entries as used
+        out.m_bytesUsed = m_count * (sizeof(Slot_t) + sizeof(Entry_t)) + m_arena.size();
+        return out;
+    }
+
+private:
+
+    static std::byte* write_bytes(std::byte* pOut, void const* pSrc, std::size_t size) noexcept
+    {
+        if (size != 0)
+        {
+            std::memcpy(pOut, pSrc, size);
+        }
+        return pOut + size;
+    }
+
+    void rehash(std::size_t slotCount)
+    {
+        m_slots.assign(slotCount, Slot_t{0, Layout_t::smc_emptySlot});
+        std::size_t const mask = slotCount - 1;
+        for (std::size_t id = 0; id < m_entries.size(); ++id)
+        {
+            Entry_t const entry = m_entries.base()[id];
+            if (entry.m_offset == Layout_t::smc_noName)
+            {
+                continue;
+            }
+            std::uint32_t const strHash = Layout_t::hash({m_arena.data() + entry.m_offset, entry.m_size});
+            std::size_t i = strHash & mask;
+            while (m_slots[i].m_id != Layout_t::smc_emptySlot)
+            {
+                i = (i + 1) & mask;
+            }
+            m_slots[i] = Slot_t{strHash, typename Layout_t::id_int_t(id)};
+        }
+    }
+
+    std::vector<Slot_t>         m_slots;
+    KeyedVec<ID_T, Entry_t>     m_entries;
+    std::vector<char>           m_arena;
+    std::size_t                 m_count{0};
+
+}; // class IdNameTable
+
+} // namespace lgrn
@@ -8,6 +8,7 @@
 
 #include "../containers/bit_view.hpp"
 #include "../utility/bitmath.hpp"
+#include "../utility/memory_stats.hpp"
 
 #include <cstdint>
 
@@ -36,6 +37,13 @@ public:
     {
         vec().resize(lgrn::div_ceil(n, Base_t::bitview().int_bitsize()), 0);
     }
+
+    MemoryStats memory_stats() const noexcept
+    {
+        MemoryStats out = vector_memory_stats(vec());
+        count_word_occupancy<true>(out, vec().data(), vec().data() + vec().size());
+        return out;
+    }
 };
 
 
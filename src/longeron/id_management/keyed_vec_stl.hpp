@@ -5,6 +5,7 @@
 #pragma once
 
 #include "../utility/enum_traits.hpp"
+#include "../utility/memory_stats.hpp"
 
 #include <vector>
 
@@ -58,6 +59,11 @@ public:
         return vector_t::operator[](std::size_t(id));
     }
 
+    MemoryStats memory_stats() const noexcept
+    {
+        return vector_memory_stats(base());
+    }
+
 }; // class KeyedVec
 
 
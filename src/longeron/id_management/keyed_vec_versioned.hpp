@@ -0,0 +1,167 @@
+/**
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: 2026 Neal Nicdao <chrisnicdao0@gmail.com>
+ */
+#pragma once
+
+#include "keyed_vec_stl.hpp"
+
+#include "../utility/bitmath.hpp"
+#include "../utility/memory_stats.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace lgrn
+{
+
+/**
+ * @brief KeyedVec that records which blocks of 64 IDs were written to, so systems can skip
+ *        blocks that haven't changed since they last ran
+ *
+ * Reads go through operator[] or base() as usual. Writes must go through write(), which tags the
+ * ID's block with the next version number. Each block of 64 blocks (4096 IDs) also stores the
+ * max version of its blocks, so unchanged regions are skipped 4096 IDs at a time.
+ *
+ * A system calls snapshot_version() when it reads, and keeps the returned value. On its next run,
+ * for_each_changed_block(lastSeen, ...) visits only blocks written to after the snapshot.
+ */
+template <typename ID_T, typename DATA_T, typename ALLOC_T = std::allocator<DATA_T>>
+class VersionedKeyedVec
+{
+public:
+
+    using Version_t = std::uint64_t;
+
+    static constexpr std::size_t smc_blockSize      = 64;
+    static constexpr std::size_t smc_superBlockSize = 64; // in blocks
+
+    using const_reference = typename KeyedVec<ID_T, DATA_T, ALLOC_T>::const_reference;
+
+    void resize(std::size_t n, DATA_T const& value = DATA_T{})
+    {
+        m_data.resize(n, value);
+        m_blockVersion.resize(div_ceil(n, smc_blockSize), 0);
+        m_superVersion.resize(div_ceil(m_blockVersion.size(), smc_superBlockSize), 0);
+    }
+
+    std::size_t size() const noexcept { return m_data.size(); }
+
+    const_reference operator[] (ID_T const id) const noexcept { return m_data[id]; }
+
+    /**
+     * @return Read-only access to the underlying KeyedVec
+     */
+    KeyedVec<ID_T, DATA_T, ALLOC_T> const& base() const noexcept { return m_data; }
+
+    /**
+     * @brief Access an entry for writing, marking its block as changed
+     */
+    DATA_T& write(ID_T const id) noexcept
+    {
+        std::size_t const block = std::size_t(id) / smc_blockSize;
+        m_blockVersion[block]                       = m_nextVersion;
+        m_superVersion[block / smc_superBlockSize]  = m_nextVersion;
+        return m_data[id];
+    }
+
+    /**
+     * @brief Mark all blocks as changed, eg: after writing through something other than write()
+     */
+    void mark_all_changed() noexcept
+    {
+        std::fill(m_blockVersion.begin(), m_blockVersion.end(), m_nextVersion);
+        std::fill(m_superVersion.begin(), m_superVersion.end(), m_nextVersion);
+    }
+
+    /**
+     * @brief Get a version to later compare changes against. Writes after this call are newer
+     *        than the returned version.
+     */
+    Version_t snapshot_version() noexcept
+    {
+        return m_nextVersion ++;
+    }
+
+    /**
+     * @return Version of the last write to a block of 64 IDs
+     */
+    Version_t block_version(std::size_t block) const noexcept { return m_blockVersion[block]; }
+
+    std::size_t block_count() const noexcept { return m_blockVersion.size(); }
+
+    /**
+     * @return true if any entry changed after a version
+     */
+    bool any_changed_since(Version_t lastSeen) const noexcept
+    {
+        return std::any_of(m_superVersion.begin(), m_superVersion.end(),
+                           [lastSeen] (Version_t const version) { return version > lastSeen; });
+    }
+
+    /**
+     * @brief Call a function for each block of 64 IDs that changed after a version
+     *
+     * @param func [in] Callable as void(ID_T first, ID_T last), for the range [first, last)
+     */
+    template<typename FUNC_T>
+    void for_each_changed_block(Version_t lastSeen, FUNC_T&& func) const
+    {
+        std::size_t const blockCount = m_blockVersion.size();
+        for (std::size_t super = 0; super < m_superVersion.size(); ++super)
+        {
+            if (m_superVersion[super] <= lastSeen)
+            {
+                continue;
+            }
+
+            std::size_t const blockLast = std::min(blockCount, (super + 1) * smc_superBlockSize);
+            for (std::size_t block = super * smc_superBlockSize; block < blockLast; ++block)
+            {
+                if (m_blockVersion[block] > lastSeen)
+                {
+                    func(ID_T(block * smc_blockSize),
+                         ID_T(std::min(m_data.size(), (block + 1) * smc_blockSize)));
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Call a function for each ID within blocks that changed after a version. May include
+     *        unchanged IDs that share a block with changed ones.
+     */
+    template<typename FUNC_T>
+    void for_each_changed(Version_t lastSeen, FUNC_T&& func) const
+    {
+        for_each_changed_block(lastSeen, [&func] (ID_T first, ID_T last)
+        {
+            for (std::size_t i = std::size_t(first); i < std::size_t(last); ++i)
+            {
+                func(ID_T(i));
+            }
+        });
+    }
+
+    MemoryStats memory_stats() const noexcept
+    {
+        return sum_memory_stats(m_data, m_blockVersion, m_superVersion);
+    }
+
+private:
+
+    KeyedVec<ID_T, DATA_T, ALLOC_T> m_data;
+
+    // [block] -> version of last write
+    std::vector<Version_t>          m_blockVersion;
+
+    // [block / smc_superBlockSize] -> max version of its blocks
+    std::vector<Version_t>          m_superVersion;
+
+    // Version assigned to writes. Starts at 1, so blocks never written to are older than any snapshot
+    Version_t                       m_nextVersion{1};
+
+}; // class VersionedKeyedVec
+
+} // namespace lgrn
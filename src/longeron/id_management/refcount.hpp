@@ -4,13 +4,50 @@
  */
 #pragma once
 
+#include "id_set_stl.hpp"
 #include "owner.hpp"
 
+#include "../utility/memory_stats.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <unordered_map>
 #include <vector>
 
 namespace lgrn
 {
 
+/**
+ * @return true if all integers in [first, last) are zero
+ */
+template<typename INT_T>
+bool all_zeros(INT_T const* first, INT_T const* const last) noexcept
+{
+    // OR together fixed-size blocks without branching, which compilers can vectorize. Only
+    // test the result once per block.
+    constexpr std::size_t const blockSize = 64;
+    while (std::size_t(last - first) >= blockSize)
+    {
+        INT_T combined = 0;
+        for (std::size_t i = 0; i < blockSize; ++i)
+        {
+            combined |= first[i];
+        }
+        if (combined != 0)
+        {
+            return false;
+        }
+        first += blockSize;
+    }
+
+    INT_T combined = 0;
+    for (; first != last; ++first)
+    {
+        combined |= *first;
+    }
+    return combined == 0;
+}
+
 template<typename COUNT_T = unsigned short>
 class RefCount : std::vector<COUNT_T>
 {
@@ -30,7 +67,7 @@ public:
     // Allow move assign only if all counts are zero
     RefCount& operator=(RefCount&& move)
     {
-        LGRN_ASSERTM(only_zeros_remaining(0), "Cannot clear non-zero reference counts");
+        LGRN_ASSERTM_EXPENSIVE(only_zeros_remaining(0), "Cannot clear non-zero reference counts");
         base_t::operator=(std::move(move));
         return *this;
     }
@@ -38,36 +75,204 @@ public:
     ~RefCount()
     {
         // Make sure ref counts are all zero on destruction
-        LGRN_ASSERTM(only_zeros_remaining(0), "Cannot destruct with non-zero reference counts");
+        LGRN_ASSERTM_EXPENSIVE(only_zeros_remaining(0), "Cannot destruct with non-zero reference counts");
     }
 
     bool only_zeros_remaining(std::size_t start) const noexcept
     {
-        for(auto it = std::next(base_t::begin(), start); it != base_t::end(); std::advance(it, 1))
-        {
-            if (0 != *it)
-            {
-                return false;
-            }
-        }
-        return true;
+        return (start >= size()) || all_zeros(base_t::data() + start, base_t::data() + size());
     }
 
     using base_t::size;
     using base_t::operator[];
 
+    /**
+     * @return Count after incrementing
+     */
+    COUNT_T increment(std::size_t i) noexcept
+    {
+        LGRN_ASSERTMV_CHEAP((*this)[i] != COUNT_T(~COUNT_T(0)), "Reference count overflow", i);
+        return ++ (*this)[i];
+    }
+
+    /**
+     * @return Count after decrementing
+     */
+    COUNT_T decrement(std::size_t i) noexcept
+    {
+        LGRN_ASSERTMV_CHEAP((*this)[i] != 0, "Reference count underflow", i);
+        return -- (*this)[i];
+    }
+
     void resize(std::size_t newSize)
     {
-        LGRN_ASSERTMV(!(newSize < size() && !only_zeros_remaining(newSize)),
+        LGRN_ASSERTMV_EXPENSIVE(!(newSize < size() && !only_zeros_remaining(newSize)),
                      "Downsizing will clear non-zero reference counts", newSize, size());
         base_t::resize(newSize, 0);
     }
 
+    MemoryStats memory_stats() const noexcept
+    {
+        return vector_memory_stats(static_cast<base_t const&>(*this));
+    }
+
 }; // class RefCount
 
+/**
+ * @brief Reference counts stored as a single byte each
+ *
+ * Intended for very large numbers of IDs that are rarely referenced more than a few times. Counts
+ * that don't fit in a byte are marked with a sentinel value and spill into a hash map, so they
+ * never silently wrap around.
+ */
+class RefCountCompact
+{
+    static constexpr std::uint8_t smc_spilled = 0xFF;
+
+public:
+
+    RefCountCompact() = default;
+    RefCountCompact(RefCountCompact&& move) = default;
+    RefCountCompact(std::size_t capacity)
+     : m_counts( capacity, 0 )
+    { };
+
+    // Delete copy
+    RefCountCompact(RefCountCompact const& copy) = delete;
+    RefCountCompact& operator=(RefCountCompact const& copy) = delete;
+
+    // Allow move assign only if all counts are zero
+    RefCountCompact& operator=(RefCountCompact&& move)
+    {
+        LGRN_ASSERTM_EXPENSIVE(only_zeros_remaining(0), "Cannot clear non-zero reference counts");
+        m_counts = std::move(move.m_counts);
+        m_spill  = std::move(move.m_spill);
+        return *this;
+    }
+
+    ~RefCountCompact()
+    {
+        LGRN_ASSERTM_EXPENSIVE(only_zeros_remaining(0), "Cannot destruct with non-zero reference counts");
+    }
+
+    bool only_zeros_remaining(std::size_t start) const noexcept
+    {
+        // Spilled counts are non-zero bytes too, no need to check m_spill
+        return (start >= size()) || all_zeros(m_counts.data() + start, m_counts.data() + size());
+    }
+
+    std::size_t size() const noexcept { return m_counts.size(); }
+
+    std::size_t operator[](std::size_t i) const
+    {
+        std::uint8_t const count = m_counts[i];
+        return (count != smc_spilled) ? count : m_spill.at(i);
+    }
+
+    /**
+     * @return Count after incrementing
+     */
+    std::size_t increment(std::size_t i)
+    {
+        std::uint8_t &rCount = m_counts[i];
+        if (rCount < smc_spilled - 1)
+        {
+            return ++rCount;
+        }
+        else if (rCount == smc_spilled - 1)
+        {
+            rCount = smc_spilled;
+            m_spill[i] = smc_spilled;
+            return smc_spilled;
+        }
+        else
+        {
+            std::size_t &rSpill = m_spill.at(i);
+            LGRN_ASSERTMV_CHEAP(rSpill != ~std::size_t(0), "Reference count overflow", i);
+            return ++rSpill;
+        }
+    }
+
+    /**
+     * @return Count after decrementing
+     */
+    std::size_t decrement(std::size_t i)
+    {
+        std::uint8_t &rCount = m_counts[i];
+        LGRN_ASSERTMV_CHEAP(rCount != 0, "Reference count underflow", i);
+        if (rCount != smc_spilled)
+        {
+            return --rCount;
+        }
+
+        auto const it = m_spill.find(i);
+        std::size_t const count = -- it->second;
+        if (count == smc_spilled - 1)
+        {
+            // Fits in a byte again
+            m_spill.erase(it);
+            rCount = smc_spilled - 1;
+        }
+        return count;
+    }
+
+    void resize(std::size_t newSize)
+    {
+        LGRN_ASSERTMV_EXPENSIVE(!(newSize < size() && !only_zeros_remaining(newSize)),
+                     "Downsizing will clear non-zero reference counts", newSize, size());
+        m_counts.resize(newSize, 0);
+    }
+
+    /**
+     * @return Number of counts that don't fit in a byte
+     */
+    std::size_t spilled_count() const noexcept { return m_spill.size(); }
+
+    /**
+     * @brief Spilled counts are counted as one map value each, ignoring node overhead
+     */
+    MemoryStats memory_stats() const noexcept
+    {
+        MemoryStats out = vector_memory_stats(m_counts);
+        std::size_t const spillBytes = m_spill.size() * sizeof(decltype(m_spill)::value_type);
+        out.m_bytesReserved += spillBytes;
+        out.m_bytesUsed     += spillBytes;
+        return out;
+    }
+
+private:
+
+    std::vector<std::uint8_t>                       m_counts;
+    std::unordered_map<std::size_t, std::size_t>    m_spill;
+
+}; // class RefCountCompact
+
+/**
+ * @brief Use as IdRefCount's COUNT_T to select RefCountCompact storage
+ */
+struct CompactCount { };
+
+template<typename COUNT_T>
+struct refcount_storage { using type = RefCount<COUNT_T>; };
+
+template<>
+struct refcount_storage<CompactCount> { using type = RefCountCompact; };
+
+template<typename COUNT_T>
+using refcount_storage_t = typename refcount_storage<COUNT_T>::type;
+
+/**
+ * @brief Reference counts associated with IDs, handed out as IdOwners
+ *
+ * IDs whose reference count drops to zero are recorded in a set, see zeros(). This allows
+ * resources of newly unreferenced IDs to be destroyed in a batch without scanning every count.
+ *
+ * Use CompactCount as COUNT_T to store counts in a single byte each (see RefCountCompact).
+ */
 template<typename ID_T, typename COUNT_T = unsigned short>
-class IdRefCount : public RefCount<COUNT_T>
+class IdRefCount : public refcount_storage_t<COUNT_T>
 {
+    using base_t   = refcount_storage_t<COUNT_T>;
     using id_int_t = underlying_int_type_t<ID_T>;
 
 public:
@@ -79,9 +284,13 @@ public:
         auto const idInt = id_int_t(id);
         if (this->size() <= idInt)
         {
-            this->resize(idInt + 1);
+            resize(idInt + 1);
+        }
+        if (this->increment(idInt) == 1)
+        {
+            // Referenced again before zeros were cleared
+            m_zeros.erase(id);
         }
-        (*this)[idInt] ++;
 
         return Owner_t(id);
     }
@@ -91,11 +300,88 @@ public:
         if (rStorage.has_value())
         {
             auto const idInt = id_int_t(rStorage.m_id);
-            (*this)[idInt] --;
+            if (this->decrement(idInt) == 0)
+            {
+                m_zeros.insert(rStorage.m_id);
+            }
             rStorage.m_id = id_null<ID_T>();
         }
     }
 
+    /**
+     * @brief Add a reference to each ID in a range, and write their new owners to another range
+     *
+     * Capacity is only checked and reallocated once for the whole range.
+     *
+     * @param first [in] Forward iterator to IDs
+     * @param last  [in] Sentinel of IDs
+     * @param out   [out] Output iterator to empty Owner_t
+     *
+     * @return Output iterator that is one past the last owner written to
+     */
+    template<typename ITER_T, typename SNTL_T, typename OUT_T>
+    OUT_T ref_add_many(ITER_T first, SNTL_T const last, OUT_T out)
+    {
+        std::size_t requiredSize = this->size();
+        for (ITER_T it = first; it != last; ++it)
+        {
+            requiredSize = std::max<std::size_t>(requiredSize, id_int_t(ID_T{*it}) + 1);
+        }
+        if (this->size() < requiredSize)
+        {
+            resize(requiredSize);
+        }
+
+        for (; first != last; ++first, ++out)
+        {
+            ID_T const id = *first;
+            if (this->increment(id_int_t(id)) == 1)
+            {
+                m_zeros.erase(id);
+            }
+            *out = Owner_t(id);
+        }
+        return out;
+    }
+
+    /**
+     * @brief Release each owner in a range. Owners without a value are skipped
+     *
+     * @param first [in] Iterator to Owner_t
+     * @param last  [in] Sentinel of Owner_t
+     */
+    template<typename ITER_T, typename SNTL_T>
+    void ref_release_many(ITER_T first, SNTL_T const last) noexcept
+    {
+        for (; first != last; ++first)
+        {
+            ref_release(std::move(*first));
+        }
+    }
+
+    void resize(std::size_t newSize)
+    {
+        base_t::resize(newSize);
+        m_zeros.resize(newSize);
+    }
+
+    /**
+     * @return Set of IDs that had their reference count reach zero since the last clear_zeros().
+     *         Every ID in this set currently has zero references.
+     */
+    IdSetStl<ID_T> const& zeros() const noexcept { return m_zeros; }
+
+    void clear_zeros() noexcept { m_zeros.clear(); }
+
+    MemoryStats memory_stats() const noexcept
+    {
+        return sum_memory_stats(base_t::memory_stats(), m_zeros);
+    }
+
+private:
+
+    IdSetStl<ID_T> m_zeros;
+
 }; // class IdRefCount
 
 } // namespace lgrn
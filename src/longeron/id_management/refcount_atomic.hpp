@@ -0,0 +1,178 @@
+/**
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: 2026 Neal Nicdao <chrisnicdao0@gmail.com>
+ */
+#pragma once
+
+#include "owner.hpp"
+
+#include "../utility/bitmath.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+namespace lgrn
+{
+
+/**
+ * @brief Thread-safe reference counts for IDs, with a fixed capacity
+ *
+ * Unlike IdRefCount, this never reallocates, so ref_add and ref_release can be called from
+ * multiple threads at once. Increments are relaxed, as taking a reference to an ID the caller
+ * already knows about does not need to synchronize anything. Decrements are acq_rel so that
+ * whoever observes a count reaching zero also observes all writes made by previous owners.
+ *
+ * IDs whose count reaches zero are recorded in a lock-free bitset ("zeros"). This allows a single
+ * thread to later collect and destroy unreferenced resources in a batch using collect_zeros().
+ */
+template<typename ID_T, typename COUNT_T = unsigned short>
+class AtomicIdRefCount
+{
+    using id_int_t  = underlying_int_type_t<ID_T>;
+    using Count_t   = std::atomic<COUNT_T>;
+    using Bits_t    = std::atomic<std::uint64_t>;
+
+    static constexpr std::size_t smc_bitSize = 64;
+
+public:
+
+    using Owner_t = IdOwner<ID_T, AtomicIdRefCount>;
+
+    AtomicIdRefCount() = default;
+    AtomicIdRefCount(std::size_t capacity)
+     : m_counts     { new Count_t[capacity]{} }
+     , m_zeros      { new Bits_t[div_ceil(capacity, smc_bitSize)]{} }
+     , m_capacity   { capacity }
+    { }
+    AtomicIdRefCount(AtomicIdRefCount&& move) noexcept
+     : m_counts     { std::move(move.m_counts) }
+     , m_zeros      { std::move(move.m_zeros) }
+     , m_capacity   { std::exchange(move.m_capacity, 0) }
+    { }
+
+    // Delete copy
+    AtomicIdRefCount(AtomicIdRefCount const& copy) = delete;
+    AtomicIdRefCount& operator=(AtomicIdRefCount const& copy) = delete;
+
+    // Allow move assign only if all counts are zero
+    AtomicIdRefCount& operator=(AtomicIdRefCount&& move) noexcept
+    {
+        LGRN_ASSERTM_EXPENSIVE(only_zeros_remaining(), "Cannot clear non-zero reference counts");
+        m_counts    = std::move(move.m_counts);
+        m_zeros     = std::move(move.m_zeros);
+        m_capacity  = std::exchange(move.m_capacity, 0);
+        return *this;
+    }
+
+    ~AtomicIdRefCount()
+    {
+        LGRN_ASSERTM_EXPENSIVE(only_zeros_remaining(), "Cannot destruct with non-zero reference counts");
+    }
+
+    constexpr std::size_t capacity() const noexcept { return m_capacity; }
+
+    /**
+     * @brief Add a reference to an ID. Thread-safe
+     *
+     * The ID must be less than capacity().
+     */
+    [[nodiscard]] Owner_t ref_add(ID_T id) noexcept
+    {
+        auto const idInt = std::size_t(id_int_t(id));
+        LGRN_ASSERTMV_CHEAP(idInt < m_capacity, "ID out of range", idInt, m_capacity);
+
+        [[maybe_unused]] COUNT_T const prev = m_counts[idInt].fetch_add(1, std::memory_order_relaxed);
+        LGRN_ASSERTMV_CHEAP(prev != COUNT_T(~COUNT_T(0)), "Reference count overflow", idInt);
+
+        return Owner_t(id);
+    }
+
+    /**
+     * @brief Release a reference to an ID, and mark it as a zero if no references remain.
+     *        Thread-safe
+     */
+    void ref_release(Owner_t&& rOwner) noexcept
+    {
+        if (rOwner.has_value())
+        {
+            auto const idInt = std::size_t(id_int_t(rOwner.m_id));
+            COUNT_T const prev = m_counts[idInt].fetch_sub(1, std::memory_order_acq_rel);
+            LGRN_ASSERTMV_CHEAP(prev != 0, "Reference count underflow", idInt);
+
+            if (prev == 1)
+            {
+                m_zeros[idInt / smc_bitSize].fetch_or(std::uint64_t(1) << (idInt % smc_bitSize),
+                                                      std::memory_order_release);
+            }
+
+            rOwner.m_id = id_null<ID_T>();
+        }
+    }
+
+    /**
+     * @return Current reference count of an ID. May be outdated as soon as it's returned if other
+     *         threads are adding or releasing references.
+     */
+    COUNT_T count(ID_T id) const noexcept
+    {
+        auto const idInt = std::size_t(id_int_t(id));
+        LGRN_ASSERTMV_CHEAP(idInt < m_capacity, "ID out of range", idInt, m_capacity);
+        return m_counts[idInt].load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Call a function for each ID that reached zero references since the last call, then
+     *        forget them
+     *
+     * IDs that were given a new reference after reaching zero are skipped. Only one thread should
+     * collect at a time, but other threads are allowed to keep adding and releasing references.
+     *
+     * @param func  [in] Callable as void(ID_T)
+     */
+    template<typename FUNC_T>
+    void collect_zeros(FUNC_T&& func)
+    {
+        std::size_t const words = div_ceil(m_capacity, smc_bitSize);
+        for (std::size_t i = 0; i < words; ++i)
+        {
+            if (m_zeros[i].load(std::memory_order_relaxed) == 0)
+            {
+                continue;
+            }
+
+            std::uint64_t bits = m_zeros[i].exchange(0, std::memory_order_acq_rel);
+            while (bits != 0)
+            {
+                std::size_t const idInt = i * smc_bitSize + ctz(bits);
+                bits &= bits - 1;
+
+                if (m_counts[idInt].load(std::memory_order_acquire) == 0)
+                {
+                    func(ID_T(idInt));
+                }
+            }
+        }
+    }
+
+    bool only_zeros_remaining() const noexcept
+    {
+        for (std::size_t i = 0; i < m_capacity; ++i)
+        {
+            if (m_counts[i].load(std::memory_order_relaxed) != 0)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+private:
+
+    std::unique_ptr<Count_t[]>  m_counts;
+    std::unique_ptr<Bits_t[]>   m_zeros;
+    std::size_t                 m_capacity{0};
+
+}; // class AtomicIdRefCount
+
+} // namespace lgrn
@@ -7,6 +7,8 @@
 #include "bitview_registry.hpp"
 #include "../containers/bit_view.hpp"
 #include "../utility/bitmath.hpp"
+#include "../utility/memory_stats.hpp"
+#include "../utility/trace.hpp"
 
 #include <vector>
 
@@ -100,6 +102,16 @@ public:
     [[nodiscard]] constexpr auto&       vec()       noexcept { return Base_t::bitview().ints(); }
     [[nodiscard]] constexpr auto const& vec() const noexcept { return Base_t::bitview().ints(); }
 
+    /**
+     * @brief Memory used, and how many words have all, some, or none of their IDs taken
+     */
+    MemoryStats memory_stats() const noexcept
+    {
+        MemoryStats out = vector_memory_stats(vec());
+        count_word_occupancy<false>(out, vec().data(), vec().data() + vec().size());
+        return out;
+    }
+
 private:
 
     /**
@@ -107,6 +119,9 @@ private:
      */
     void reserve_auto()
     {
+        LGRN_TRACE("IdRegistryStl::reserve_auto");
+        LGRN_COUNTER("IdRegistryStl reallocations");
+
         // initialize to all bits set, as ones are for free IDs
         // semi-jank way to use vector's automatic reallocation logic
         vec().push_back(~uint64_t(0));
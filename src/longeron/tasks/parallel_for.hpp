@@ -0,0 +1,86 @@
+/**
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: 2026 Neal Nicdao <chrisnicdao0@gmail.com>
+ */
+#pragma once
+
+#include "thread_pool.hpp"
+
+#include "../id_management/id_set_stl.hpp"
+#include "../utility/bitmath.hpp"
+
+#include <algorithm>
+
+namespace lgrn
+{
+
+/**
+ * @brief Run a function on chunks of a range of indices in parallel, and wait for all of them
+ *
+ * The calling thread helps run chunks while waiting, so this can be called from within tasks.
+ *
+ * @param rPool     [ref] Pool to run chunks on
+ * @param size      [in] Number of indices, [0, size)
+ * @param chunkSize [in] Number of indices per task
+ * @param func      [in] Callable as void(std::size_t first, std::size_t last)
+ */
+template<typename FUNC_T>
+void parallel_for_chunks(ThreadPool& rPool, std::size_t size, std::size_t chunkSize, FUNC_T const& func)
+{
+    chunkSize = std::max<std::size_t>(chunkSize, 1);
+    std::size_t const chunks = div_ceil(size, chunkSize);
+    if (chunks == 0)
+    {
+        return;
+    }
+
+    std::atomic<std::size_t> chunksDone{0};
+
+    // Keep one chunk for the calling thread
+    for (std::size_t i = 1; i < chunks; ++i)
+    {
+        rPool.submit([&func, &chunksDone, i, size, chunkSize] ()
+        {
+            func(i * chunkSize, std::min(size, (i + 1) * chunkSize));
+            chunksDone.fetch_add(1, std::memory_order_release);
+        });
+    }
+    func(0, std::min(size, chunkSize));
+    chunksDone.fetch_add(1, std::memory_order_release);
+
+    rPool.help_until([&chunksDone, chunks] ()
+    {
+        return chunksDone.load(std::memory_order_acquire) == chunks;
+    });
+}
+
+/**
+ * @brief Call a function for each ID in an IdSetStl in parallel, split into chunks of 64-bit words
+ *
+ * @param rPool         [ref] Pool to run chunks on
+ * @param set           [in] Set of IDs. Must not be modified until this returns.
+ * @param wordsPerChunk [in] Number of 64-bit words (64 IDs each) per task
+ * @param func          [in] Callable as void(ID_T), called concurrently from multiple threads
+ */
+template<typename ID_T, typename FUNC_T>
+void parallel_for_each(ThreadPool& rPool, IdSetStl<ID_T> const& set, std::size_t wordsPerChunk, FUNC_T const& func)
+{
+    auto const &words = set.vec();
+    constexpr std::size_t const wordBits = 64;
+
+    parallel_for_chunks(rPool, words.size(), wordsPerChunk,
+                        [&words, &func] (std::size_t first, std::size_t last)
+    {
+        for (std::size_t i = first; i < last; ++i)
+        {
+            std::uint64_t bits = words[i];
+            while (bits != 0)
+            {
+                func(ID_T(i * wordBits + ctz(bits)));
+                bits &= bits - 1;
+            }
+        }
+    });
+}
+
+} // namespace lgrn
@@ -0,0 +1,216 @@
+/**
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: 2026 Neal Nicdao <chrisnicdao0@gmail.com>
+ */
+#pragma once
+
+#include "thread_pool.hpp"
+
+#include "../utility/asserts.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace lgrn
+{
+
+/**
+ * @brief Containers that a system reads from and writes to. Containers are identified by address.
+ */
+struct SystemAccess
+{
+    template<typename ... T>
+    SystemAccess& read(T const& ... containers)
+    {
+        ( m_reads.push_back(static_cast<void const*>(&containers)), ... );
+        return *this;
+    }
+
+    template<typename ... T>
+    SystemAccess& write(T& ... containers)
+    {
+        ( m_writes.push_back(static_cast<void const*>(&containers)), ... );
+        return *this;
+    }
+
+    std::vector<void const*> m_reads;
+    std::vector<void const*> m_writes;
+};
+
+/**
+ * @brief Runs systems in parallel based on which containers they read and write
+ *
+ * Systems are added in the order they would run on a single thread. A system depends on all
+ * earlier systems it conflicts with, where a conflict is any write to a container that the other
+ * system reads or writes. Systems with no path between them in this dependency graph run
+ * concurrently. Results are the same as running all systems in order.
+ *
+ * The graph is rebuilt on the next run() after systems are added.
+ */
+class SystemScheduler
+{
+public:
+
+    using SystemId  = std::size_t;
+    using Func_t    = std::function<void()>;
+
+    SystemId add(std::string name, Func_t func, SystemAccess access)
+    {
+        std::sort(access.m_reads.begin(), access.m_reads.end());
+        std::sort(access.m_writes.begin(), access.m_writes.end());
+
+        m_systems.push_back({std::move(name), std::move(func), std::move(access)});
+        m_graphDirty = true;
+        return m_systems.size() - 1;
+    }
+
+    std::size_t size() const noexcept { return m_systems.size(); }
+
+    std::string const& name(SystemId id) const { return m_systems[id].m_name; }
+
+    /**
+     * @return Systems that must complete before a system can run
+     */
+    std::vector<SystemId> dependencies(SystemId id)
+    {
+        build_graph();
+        std::vector<SystemId> out;
+        for (SystemId other = 0; other < id; ++other)
+        {
+            auto const &dependents = m_dependents[other];
+            if (std::find(dependents.begin(), dependents.end(), id) != dependents.end())
+            {
+                out.push_back(other);
+            }
+        }
+        return out;
+    }
+
+    /**
+     * @brief Run all systems once, and wait for them to complete
+     *
+     * The calling thread helps run systems while waiting.
+     */
+    void run(ThreadPool& rPool)
+    {
+        build_graph();
+
+        std::size_t const count = m_systems.size();
+        if (count == 0)
+        {
+            return;
+        }
+
+        std::unique_ptr<std::atomic<std::size_t>[]> remaining{new std::atomic<std::size_t>[count]};
+        for (SystemId id = 0; id < count; ++id)
+        {
+            remaining[id].store(m_dependencyCount[id], std::memory_order_relaxed);
+        }
+        std::atomic<std::size_t> done{0};
+
+        // Run a system, then launch dependents that are no longer waiting on anything
+        std::function<void(SystemId)> launch;
+        launch = [this, &rPool, &remaining, &done, &launch] (SystemId id)
+        {
+            m_systems[id].m_func();
+
+            for (SystemId const dependent : m_dependents[id])
+            {
+                if (remaining[dependent].fetch_sub(1, std::memory_order_acq_rel) == 1)
+                {
+                    rPool.submit([&launch, dependent] () { launch(dependent); });
+                }
+            }
+
+            // Must be last, run() returns as soon as all systems are done
+            done.fetch_add(1, std::memory_order_release);
+        };
+
+        for (SystemId id = 0; id < count; ++id)
+        {
+            if (m_dependencyCount[id] == 0)
+            {
+                rPool.submit([&launch, id] () { launch(id); });
+            }
+        }
+
+        rPool.help_until([&done, count] () { return done.load(std::memory_order_acquire) == count; });
+    }
+
+private:
+
+    struct System
+    {
+        std::string     m_name;
+        Func_t          m_func;
+        SystemAccess    m_access;
+    };
+
+    static bool intersects(std::vector<void const*> const& a, std::vector<void const*> const& b) noexcept
+    {
+        auto itA = a.begin();
+        auto itB = b.begin();
+        while (itA != a.end() && itB != b.end())
+        {
+            if (*itA < *itB)
+            {
+                ++itA;
+            }
+            else if (*itB < *itA)
+            {
+                ++itB;
+            }
+            else
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    static bool conflicts(SystemAccess const& a, SystemAccess const& b) noexcept
+    {
+        return intersects(a.m_writes, b.m_writes)
+            || intersects(a.m_writes, b.m_reads)
+            || intersects(a.m_reads,  b.m_writes);
+    }
+
+    void build_graph()
+    {
+        if ( ! m_graphDirty )
+        {
+            return;
+        }
+
+        std::size_t const count = m_systems.size();
+        m_dependents.assign(count, {});
+        m_dependencyCount.assign(count, 0);
+
+        for (SystemId later = 0; later < count; ++later)
+        {
+            for (SystemId earlier = 0; earlier < later; ++earlier)
+            {
+                if (conflicts(m_systems[earlier].m_access, m_systems[later].m_access))
+                {
+                    m_dependents[earlier].push_back(later);
+                    ++ m_dependencyCount[later];
+                }
+            }
+        }
+        m_graphDirty = false;
+    }
+
+    std::vector<System>                 m_systems;
+
+    // Dependency graph, [SystemId] -> Systems that run after
+    std::vector< std::vector<SystemId> > m_dependents;
+    std::vector<std::size_t>            m_dependencyCount;
+    bool                                m_graphDirty{false};
+
+}; // class SystemScheduler
+
+} // namespace lgrn
@@ -0,0 +1,250 @@
+/**
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: 2026 Neal Nicdao <chrisnicdao0@gmail.com>
+ */
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace lgrn
+{
+
+/**
+ * @brief Work-stealing thread pool
+ *
+ * Each worker has its own task queue. Workers take the most recently submitted task from their
+ * own queue (good for cache), and steal the oldest task from other queues when theirs is empty.
+ * Tasks submitted from outside of the pool go into an extra shared queue.
+ *
+ * Waiting for tasks is done with help_until(), which runs tasks on the calling thread instead of
+ * blocking. This allows tasks to wait on other tasks (eg: nested parallel_for) without deadlocking,
+ * and allows a pool with 0 threads to run everything on the calling thread.
+ *
+ * Idle workers sleep until a task is submitted. Threads in help_until() with nothing to run spin
+ * briefly, then sleep until a task finishes or is submitted.
+ */
+class ThreadPool
+{
+public:
+
+    using Task_t = std::function<void()>;
+
+    explicit ThreadPool(unsigned int threadCount = std::thread::hardware_concurrency())
+    {
+        // +1 for the external queue
+        m_queues.reserve(threadCount + 1);
+        for (unsigned int i = 0; i < threadCount + 1; ++i)
+        {
+            m_queues.emplace_back(std::make_unique<Queue>());
+        }
+
+        m_threads.reserve(threadCount);
+        for (unsigned int i = 0; i < threadCount; ++i)
+        {
+            m_threads.emplace_back([this, i] () { worker_main(i); });
+        }
+    }
+
+    ThreadPool(ThreadPool const& copy) = delete;
+    ThreadPool(ThreadPool&& move) = delete;
+    ThreadPool& operator=(ThreadPool const& copy) = delete;
+    ThreadPool& operator=(ThreadPool&& move) = delete;
+
+    /**
+     * @brief Stop all workers. Tasks that are still queued are not run.
+     */
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock{m_sleepMutex};
+            m_stop = true;
+        }
+        m_wake.notify_all();
+        for (std::thread &rThread : m_threads)
+        {
+            rThread.join();
+        }
+    }
+
+    unsigned int thread_count() const noexcept { return unsigned(m_threads.size()); }
+
+    /**
+     * @brief Queue a task to be run by any thread. Thread-safe
+     */
+    void submit(Task_t task)
+    {
+        // Count before pushing, so the count never goes below the number of queued tasks
+        {
+            std::lock_guard<std::mutex> lock{m_sleepMutex};
+            ++ m_pending;
+        }
+        Queue &rQueue = *m_queues[this_queue()];
+        {
+            std::lock_guard<std::mutex> lock{rQueue.m_mutex};
+            rQueue.m_tasks.push_back(std::move(task));
+        }
+        m_wake.notify_one();
+        if (m_helpersWaiting.load(std::memory_order_relaxed) != 0)
+        {
+            m_taskDone.notify_all();
+        }
+    }
+
+    /**
+     * @brief Run queued tasks on the calling thread until a condition is met
+     *
+     * @param done [in] Callable as bool(). Must become true eventually, as a result of tasks run
+     *                  by this pool or the calling thread. Checked after each task finishes.
+     */
+    template<typename FUNC_T>
+    void help_until(FUNC_T&& done)
+    {
+        unsigned int const queue = this_queue();
+        Task_t task;
+        unsigned int spins = 0;
+        while ( ! done() )
+        {
+            if (try_take(queue, task))
+            {
+                task();
+                task = nullptr;
+                task_finished();
+                spins = 0;
+            }
+            else if (spins < smc_helpSpins)
+            {
+                ++ spins;
+                std::this_thread::yield();
+            }
+            else
+            {
+                // Sleep until a task finishes (which may make done() true) or one is submitted
+                std::unique_lock<std::mutex> lock{m_sleepMutex};
+                m_helpersWaiting.fetch_add(1, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                m_taskDone.wait(lock, [this, &done] ()
+                {
+                    return done() || m_pending.load(std::memory_order_relaxed) != 0;
+                });
+                m_helpersWaiting.fetch_sub(1, std::memory_order_relaxed);
+                spins = 0;
+            }
+        }
+    }
+
+private:
+
+    struct Queue
+    {
+        std::mutex          m_mutex;
+        std::deque<Task_t>  m_tasks;
+    };
+
+    /**
+     * @return Queue owned by the calling thread, or the external queue
+     */
+    unsigned int this_queue() const noexcept
+    {
+        return (t_pCurrentPool == this) ? t_workerIndex : unsigned(m_threads.size());
+    }
+
+    /**
+     * @brief Pop the newest task from our own queue, or steal the oldest task of another queue
+     */
+    bool try_take(unsigned int queue, Task_t& rOut)
+    {
+        {
+            Queue &rOwn = *m_queues[queue];
+            std::lock_guard<std::mutex> lock{rOwn.m_mutex};
+            if ( ! rOwn.m_tasks.empty() )
+            {
+                rOut = std::move(rOwn.m_tasks.back());
+                rOwn.m_tasks.pop_back();
+                m_pending.fetch_sub(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+
+        std::size_t const queueCount = m_queues.size();
+        for (std::size_t i = 1; i < queueCount; ++i)
+        {
+            Queue &rVictim = *m_queues[(queue + i) % queueCount];
+            std::lock_guard<std::mutex> lock{rVictim.m_mutex};
+            if ( ! rVictim.m_tasks.empty() )
+            {
+                rOut = std::move(rVictim.m_tasks.front());
+                rVictim.m_tasks.pop_front();
+                m_pending.fetch_sub(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Wake threads sleeping in help_until, since the task may have made done() true
+     */
+    void task_finished()
+    {
+        // Pairs with the fence in help_until, so either the sleeping thread sees the task's
+        // effects in done(), or we see it waiting
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (m_helpersWaiting.load(std::memory_order_relaxed) != 0)
+        {
+            // Lock so the notify can't land between a helper's check of done() and its wait
+            std::lock_guard<std::mutex> lock{m_sleepMutex};
+            m_taskDone.notify_all();
+        }
+    }
+
+    void worker_main(unsigned int index)
+    {
+        t_pCurrentPool = this;
+        t_workerIndex = index;
+
+        Task_t task;
+        while (true)
+        {
+            if (try_take(index, task))
+            {
+                task();
+                task = nullptr;
+                task_finished();
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock{m_sleepMutex};
+            m_wake.wait(lock, [this] () { return m_stop || m_pending.load(std::memory_order_relaxed) != 0; });
+            if (m_stop)
+            {
+                return;
+            }
+        }
+    }
+
+    std::vector< std::unique_ptr<Queue> >   m_queues;
+    std::vector<std::thread>                m_threads;
+
+    static constexpr unsigned int smc_helpSpins = 64;
+
+    std::mutex                              m_sleepMutex;
+    std::condition_variable                 m_wake;         // Workers, on submit
+    std::condition_variable                 m_taskDone;     // help_until, on task finish or submit
+    std::atomic<unsigned int>               m_helpersWaiting{0};
+    std::atomic<std::size_t>                m_pending{0};
+    bool                                    m_stop{false};
+
+    static inline thread_local ThreadPool const *t_pCurrentPool{nullptr};
+    static inline thread_local unsigned int     t_workerIndex{0};
+
+}; // class ThreadPool
+
+} // namespace lgrn
@@ -4,70 +4,260 @@
  */
 #pragma once
 
+/**
+ * Assertions are split into levels by how much they cost, so cheap checks can stay enabled in
+ * release builds:
+ *
+ * * LGRN_ASSERT_CHEAP*     - Level 1, O(1) checks in hot paths, eg: bounds checks
+ * * LGRN_ASSERT*           - Level 2, regular checks
+ * * LGRN_ASSERT_EXPENSIVE* - Level 3, checks that scan entire containers
+ *
+ * Define LGRN_ASSERT_LEVEL to enable all levels up to and including it, or 0 to disable all.
+ * Defaults to 2, or 0 if LGRN_ASSERT_DISABLE or NDEBUG is defined. With the default, expensive
+ * checks (eg: RefCount's only_zeros_remaining()) no longer run; define LGRN_ASSERT_LEVEL=3 to
+ * bring them back.
+ *
+ * Each level has the same 4 variants: plain, V (print variables), M (message), and MV. Variables
+ * are printed with fprintf if they are arithmetic, enums, pointers, or C strings. Other types are
+ * printed through lgrn::AssertPrinter if specialized, then through their operator<< if
+ * LGRN_ASSERT_OSTREAM is defined, or as "(not printable)" otherwise. iostreams are only included
+ * with LGRN_ASSERT_OSTREAM.
+ *
+ * LGRN_ASSERT_OSTREAM, and any AssertPrinter specialization, must be the same in every
+ * translation unit of a program, and visible before the first assertion in each. Otherwise the
+ * same assert_print_var instantiation prints differently between translation units, violating
+ * the one definition rule. Set LGRN_ASSERT_OSTREAM project-wide, eg: with the
+ * LONGERON_ASSERT_OSTREAM CMake option.
+ */
+
+#include <cstdio>
+
+namespace lgrn
+{
+
+/**
+ * @brief Specialize to print other types in failed assertions, by adding:
+ *
+ * static void print(std::FILE* pFile, T const& value);
+ */
+template<typename T, typename = void>
+struct AssertPrinter { };
+
+} // namespace lgrn
+
+#ifndef LGRN_ASSERT_LEVEL
+    #if defined(LGRN_ASSERT_DISABLE) || defined(NDEBUG)
+        #define LGRN_ASSERT_LEVEL 0
+    #else
+        #define LGRN_ASSERT_LEVEL 2
+    #endif
+#endif
 
-#if defined(LGRN_ASSERT_DISABLE) || defined(NDEBUG)
-    #define LGRN_ASSERT(expr) ((void)0)
-    #define LGRN_ASSERTV(expr, ...) ((void)0)
-    #define LGRN_ASSERTM(expr, msg) ((void)0)
-    #define LGRN_ASSERTMV(expr, msg, ...) ((void)0)
-#elif defined(LGRN_ASSERT_CUSTOM)
+#if defined(LGRN_ASSERT_CUSTOM)
+    // Must define LGRN_ASSERT, LGRN_ASSERTV, LGRN_ASSERTM, and LGRN_ASSERTMV. These are used for
+    // all levels.
     LGRN_ASSERT_CUSTOM()
+    #define _LGRN_ASSERT_ON(expr)               LGRN_ASSERT(expr)
+    #define _LGRN_ASSERTV_ON(expr, ...)         LGRN_ASSERTV(expr, __VA_ARGS__)
+    #define _LGRN_ASSERTM_ON(expr, msg)         LGRN_ASSERTM(expr, msg)
+    #define _LGRN_ASSERTMV_ON(expr, msg, ...)   LGRN_ASSERTMV(expr, msg, __VA_ARGS__)
 #elif defined(LGRN_ASSERT_C)
     #include <cassert>
-    #define LGRN_ASSERT(expr) assert((expr));
-    #define LGRN_ASSERTM(expr, msg) assert(((void)msg, expr));
-    #define LGRN_ASSERTV(expr, ...) assert(expr);
-    #define LGRN_ASSERTMV(expr, msg, ...) assert(((void)msg, expr));
-#else
+    #define _LGRN_ASSERT_ON(expr) assert((expr))
+    #define _LGRN_ASSERTM_ON(expr, msg) assert(((void)msg, expr))
+    #define _LGRN_ASSERTV_ON(expr, ...) assert(expr)
+    #define _LGRN_ASSERTMV_ON(expr, msg, ...) assert(((void)msg, expr))
+#elif LGRN_ASSERT_LEVEL != 0
+    #include <cstdint>
     #include <cstdlib>
-    #include <iostream>
+    #include <type_traits>
+
+    #ifdef LGRN_ASSERT_OSTREAM
+        #include <ostream>
+        #include <sstream>
+    #endif
+    #include <utility>
 
     #ifdef __GNUC__
         #define _LGRN_FUNC() static_cast<char const*>(__PRETTY_FUNCTION__)
+        #define _LGRN_COLD __attribute__((cold, noinline))
+        #define _LGRN_UNLIKELY(expr) __builtin_expect(!!(expr), 0)
     #elif defined(_MSC_VER)
         #define _LGRN_FUNC() __FUNCSIG__
+        #define _LGRN_COLD __declspec(noinline)
+        #define _LGRN_UNLIKELY(expr) (expr)
     #endif
 
-    // Customizable extra information
+    // Customizable extra information, must be a C string
     #ifndef LGRN_ASSERT_DECORATE
         #define LGRN_ASSERT_DECORATE() ""
     #endif
 
+    namespace lgrn
+    {
+
+    /**
+     * @brief Print the first part of a failed assertion. Kept out-of-line so that the only cost
+     *        of passing assertions is a single branch.
+     */
+    _LGRN_COLD inline void assert_print_header(
+            char const* msg, char const* expr, char const* file, int line, char const* func) noexcept
+    {
+        std::fprintf(stderr, "\n\n%s\n* File: %s\n* Line: %d\n* Func: %s\n* Expr: %s\n",
+                     msg, file, line, func, expr);
+    }
+
+    [[noreturn]] _LGRN_COLD inline void assert_abort() noexcept
+    {
+        std::fputs(LGRN_ASSERT_DECORATE(), stderr);
+        std::fflush(stderr);
+        std::abort();
+    }
+
+    template<typename T, typename = void>
+    struct HasAssertPrinter : std::false_type { };
+
+    template<typename T>
+    struct HasAssertPrinter<T, std::void_t<decltype(AssertPrinter<T>::print(stderr, std::declval<T const&>()))>>
+     : std::true_type { };
+
+    #ifdef LGRN_ASSERT_OSTREAM
+    template<typename T, typename = void>
+    struct IsStreamable : std::false_type { };
+
+    template<typename T>
+    struct IsStreamable<T, std::void_t<decltype(std::declval<std::ostream&>() << std::declval<T const&>())>>
+     : std::true_type { };
+    #endif
+
+    /**
+     * @brief Print a variable of a failed assertion. Supports arithmetic types, enums, pointers,
+     *        C strings, anything else with an AssertPrinter, and anything with an operator<< if
+     *        LGRN_ASSERT_OSTREAM is defined.
+     */
+    template<typename T>
+    _LGRN_COLD void assert_print_var(char const* name, T const& value) noexcept
+    {
+        if constexpr (std::is_same_v<T, bool>)
+        {
+            std::fprintf(stderr, "  * %s: %s\n", name, value ? "true" : "false");
+        }
+        else if constexpr (std::is_enum_v<T>)
+        {
+            assert_print_var(name, static_cast<std::underlying_type_t<T>>(value));
+        }
+        else if constexpr (std::is_floating_point_v<T>)
+        {
+            std::fprintf(stderr, "  * %s: %g\n", name, double(value));
+        }
+        else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>)
+        {
+            std::fprintf(stderr, "  * %s: %lld\n", name, static_cast<long long>(value));
+        }
+        else if constexpr (std::is_integral_v<T>)
+        {
+            std::fprintf(stderr, "  * %s: %llu\n", name, static_cast<unsigned long long>(value));
+        }
+        else if constexpr (std::is_convertible_v<T, char const*>)
+        {
+            std::fprintf(stderr, "  * %s: %s\n", name, static_cast<char const*>(value));
+        }
+        else if constexpr (std::is_pointer_v<T>)
+        {
+            std::fprintf(stderr, "  * %s: %p\n", name, static_cast<void const*>(value));
+        }
+        else if constexpr (HasAssertPrinter<T>::value)
+        {
+            std::fprintf(stderr, "  * %s: ", name);
+            AssertPrinter<T>::print(stderr, value);
+            std::fputc('\n', stderr);
+        }
+        #ifdef LGRN_ASSERT_OSTREAM
+        else if constexpr (IsStreamable<T>::value)
+        {
+            std::ostringstream stream;
+            stream << value;
+            std::fprintf(stderr, "  * %s: %s\n", name, stream.str().c_str());
+        }
+        #endif
+        else
+        {
+            std::fprintf(stderr, "  * %s: (not printable)\n", name);
+        }
+    }
+
+    } // namespace lgrn
+
     // Macro nonsense
     #define _LGRN_SLIDE_10(_a, _b, _c, _d, _e, _f, _g, _h, _i, _j, OUT, ...) OUT
 
     // Allow printing 6 extra vars (or entire expressions) on assert
-    #define _LGRN_VAR_1(a) "  * " << (#a) << ": " << (a) << std::endl
-    #define _LGRN_VAR_2(a, b) _LGRN_VAR_1(a) << _LGRN_VAR_1(b)
-    #define _LGRN_VAR_3(a, b, c) _LGRN_VAR_1(a) << _LGRN_VAR_2(b, c)
-    #define _LGRN_VAR_4(a, b, c, d) _LGRN_VAR_1(a) << _LGRN_VAR_3(b, c, d)
-    #define _LGRN_VAR_5(a, b, c, d, e) _LGRN_VAR_1(a) << _LGRN_VAR_4(b, c, d, e)
-    #define _LGRN_VAR_6(a, b, c, d, e, f) _LGRN_VAR_1(a) << _LGRN_VAR_5(b, c, d, e, f)
+    #define _LGRN_VAR_1(a) ::lgrn::assert_print_var(#a, (a));
+    #define _LGRN_VAR_2(a, b) _LGRN_VAR_1(a) _LGRN_VAR_1(b)
+    #define _LGRN_VAR_3(a, b, c) _LGRN_VAR_1(a) _LGRN_VAR_2(b, c)
+    #define _LGRN_VAR_4(a, b, c, d) _LGRN_VAR_1(a) _LGRN_VAR_3(b, c, d)
+    #define _LGRN_VAR_5(a, b, c, d, e) _LGRN_VAR_1(a) _LGRN_VAR_4(b, c, d, e)
+    #define _LGRN_VAR_6(a, b, c, d, e, f) _LGRN_VAR_1(a) _LGRN_VAR_5(b, c, d, e, f)
 
     // Call a _LGRN_VAR_N depending on number of __VA_ARGS__
-    #define _LGRN_VAR(...) "* Vars:" << std::endl << _LGRN_SLIDE_10( \
+    #define _LGRN_VAR(...) std::fputs("* Vars:\n", stderr); _LGRN_SLIDE_10( \
             __VA_ARGS__, 0, 0, 0, 0, _LGRN_VAR_6, _LGRN_VAR_5, _LGRN_VAR_4, \
             _LGRN_VAR_3, _LGRN_VAR_2, _LGRN_VAR_1)(__VA_ARGS__)
 
-    #define _LGRN_HEADER(msg) std::endl << std::endl << msg << std::endl
-    #define _LGRN_INFO()   "* File: " << __FILE__ << std::endl \
-                        << "* Line: " << __LINE__ << std::endl \
-                        << "* Func: " << _LGRN_FUNC() << std::endl
-
     // Assert 'template'
-    #define _LGRN_ASSERT(expr, msg, extra)                  \
-    if (!(expr))                                            \
-    {                                                       \
-        std::cerr << _LGRN_HEADER(msg) << _LGRN_INFO()      \
-                  << "* Expr: " << (#expr) << std::endl     \
-                  << extra << LGRN_ASSERT_DECORATE();       \
-        std::abort();                                       \
-    }                                                       \
+    #define _LGRN_ASSERT(expr, msg, extra)                                          \
+    if (_LGRN_UNLIKELY(!(expr)))                                                    \
+    {                                                                               \
+        ::lgrn::assert_print_header(msg, #expr, __FILE__, __LINE__, _LGRN_FUNC());  \
+        extra                                                                       \
+        ::lgrn::assert_abort();                                                     \
+    }                                                                               \
     ((void)0) // require semicolon
 
-    // Usable assert functions
-    #define LGRN_ASSERT(expr) _LGRN_ASSERT(expr, "Assertion Failed!", "")
-    #define LGRN_ASSERTV(expr, ...) _LGRN_ASSERT(expr, "Assertion Failed!", _LGRN_VAR(__VA_ARGS__))
-    #define LGRN_ASSERTM(expr, msg) _LGRN_ASSERT(expr, "Assertion Failed: " msg, "")
-    #define LGRN_ASSERTMV(expr, msg, ...) _LGRN_ASSERT(expr, "Assertion Failed: " msg, _LGRN_VAR(__VA_ARGS__))
+    #define _LGRN_ASSERT_ON(expr) _LGRN_ASSERT(expr, "Assertion Failed!", )
+    #define _LGRN_ASSERTV_ON(expr, ...) _LGRN_ASSERT(expr, "Assertion Failed!", _LGRN_VAR(__VA_ARGS__))
+    #define _LGRN_ASSERTM_ON(expr, msg) _LGRN_ASSERT(expr, "Assertion Failed: " msg, )
+    #define _LGRN_ASSERTMV_ON(expr, msg, ...) _LGRN_ASSERT(expr, "Assertion Failed: " msg, _LGRN_VAR(__VA_ARGS__))
+#endif
+
+#define _LGRN_ASSERT_OFF(...) ((void)0)
+
+// Usable assert functions, enabled by level
+
+#if LGRN_ASSERT_LEVEL >= 1
+    #define LGRN_ASSERT_CHEAP(expr)             _LGRN_ASSERT_ON(expr)
+    #define LGRN_ASSERTV_CHEAP(expr, ...)       _LGRN_ASSERTV_ON(expr, __VA_ARGS__)
+    #define LGRN_ASSERTM_CHEAP(expr, msg)       _LGRN_ASSERTM_ON(expr, msg)
+    #define LGRN_ASSERTMV_CHEAP(expr, msg, ...) _LGRN_ASSERTMV_ON(expr, msg, __VA_ARGS__)
+#else
+    #define LGRN_ASSERT_CHEAP(...)              _LGRN_ASSERT_OFF()
+    #define LGRN_ASSERTV_CHEAP(...)             _LGRN_ASSERT_OFF()
+    #define LGRN_ASSERTM_CHEAP(...)             _LGRN_ASSERT_OFF()
+    #define LGRN_ASSERTMV_CHEAP(...)            _LGRN_ASSERT_OFF()
+#endif
+
+#if !defined(LGRN_ASSERT_CUSTOM)
+    #if LGRN_ASSERT_LEVEL >= 2
+        #define LGRN_ASSERT(expr)               _LGRN_ASSERT_ON(expr)
+        #define LGRN_ASSERTV(expr, ...)         _LGRN_ASSERTV_ON(expr, __VA_ARGS__)
+        #define LGRN_ASSERTM(expr, msg)         _LGRN_ASSERTM_ON(expr, msg)
+        #define LGRN_ASSERTMV(expr, msg, ...)   _LGRN_ASSERTMV_ON(expr, msg, __VA_ARGS__)
+    #else
+        #define LGRN_ASSERT(...)                _LGRN_ASSERT_OFF()
+        #define LGRN_ASSERTV(...)               _LGRN_ASSERT_OFF()
+        #define LGRN_ASSERTM(...)               _LGRN_ASSERT_OFF()
+        #define LGRN_ASSERTMV(...)              _LGRN_ASSERT_OFF()
+    #endif
+#endif
+
+#if LGRN_ASSERT_LEVEL >= 3
+    #define LGRN_ASSERT_EXPENSIVE(expr)             _LGRN_ASSERT_ON(expr)
+    #define LGRN_ASSERTV_EXPENSIVE(expr, ...)       _LGRN_ASSERTV_ON(expr, __VA_ARGS__)
+    #define LGRN_ASSERTM_EXPENSIVE(expr, msg)       _LGRN_ASSERTM_ON(expr, msg)
+    #define LGRN_ASSERTMV_EXPENSIVE(expr, msg, ...) _LGRN_ASSERTMV_ON(expr, msg, __VA_ARGS__)
+#else
+    #define LGRN_ASSERT_EXPENSIVE(...)              _LGRN_ASSERT_OFF()
+    #define LGRN_ASSERTV_EXPENSIVE(...)             _LGRN_ASSERT_OFF()
+    #define LGRN_ASSERTM_EXPENSIVE(...)             _LGRN_ASSERT_OFF()
+    #define LGRN_ASSERTMV_EXPENSIVE(...)            _LGRN_ASSERT_OFF()
 #endif
@@ -18,6 +18,7 @@ namespace lgrn
 #ifdef __GNUC__
 
     inline int ctz(uint64_t a) noexcept { return __builtin_ctzll(a); }
+    inline int popcount(uint64_t a) noexcept { return __builtin_popcountll(a); }
 
 #elif defined(_MSC_VER)
 
@@ -27,6 +28,7 @@ namespace lgrn
         _BitScanForward64(&b, a);
         return b;
     }
+    inline int popcount(uint64_t a) noexcept { return int(__popcnt64(a)); }
 
 #elif
 
@@ -0,0 +1,145 @@
+/**
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: 2026 Neal Nicdao <chrisnicdao0@gmail.com>
+ */
+#pragma once
+
+#include "bitmath.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+namespace lgrn
+{
+
+/**
+ * @brief Memory usage and fragmentation of one or more containers
+ *
+ * Returned by the memory_stats() member function of containers. Stats of multiple containers can
+ * be added together with operator+= or sum_memory_stats().
+ */
+struct MemoryStats
+{
+    // Bytes allocated on the heap, including unused capacity
+    std::size_t m_bytesReserved{0};
+
+    // Bytes of m_bytesReserved that hold live elements
+    std::size_t m_bytesUsed{0};
+
+    // Unused gaps between live elements, that can be removed by packing
+    std::size_t m_holeCount{0};
+    std::size_t m_largestHoleBytes{0};
+
+    // Occupancy of bitset words. Occupied means a used ID for registries, or a contained ID
+    // for sets.
+    std::size_t m_wordsEmpty{0};
+    std::size_t m_wordsFull{0};
+    std::size_t m_wordsPartial{0};
+
+    constexpr MemoryStats& operator+=(MemoryStats const& rhs) noexcept
+    {
+        m_bytesReserved     += rhs.m_bytesReserved;
+        m_bytesUsed         += rhs.m_bytesUsed;
+        m_holeCount         += rhs.m_holeCount;
+        m_largestHoleBytes  = std::max(m_largestHoleBytes, rhs.m_largestHoleBytes);
+        m_wordsEmpty        += rhs.m_wordsEmpty;
+        m_wordsFull         += rhs.m_wordsFull;
+        m_wordsPartial      += rhs.m_wordsPartial;
+        return *this;
+    }
+
+    constexpr std::size_t bytes_unused() const noexcept { return m_bytesReserved - m_bytesUsed; }
+};
+
+/**
+ * @brief Memory stats of an std::vector, where all elements are considered used
+ */
+template<typename T, typename ALLOC_T>
+constexpr MemoryStats vector_memory_stats(std::vector<T, ALLOC_T> const& vec) noexcept
+{
+    return { vec.capacity() * sizeof(T), vec.size() * sizeof(T) };
+}
+
+/**
+ * @brief Count empty, full, and partially occupied words of a bitset
+ *
+ * @tparam ONES_OCCUPIED    true if set bits are occupied (sets), false if cleared bits are
+ *                          occupied (registries, where set bits are free IDs)
+ */
+template<bool ONES_OCCUPIED, typename INT_T>
+constexpr void count_word_occupancy(MemoryStats &rStats, INT_T const* first, INT_T const* last) noexcept
+{
+    for (; first != last; ++first)
+    {
+        INT_T const occupied = ONES_OCCUPIED ? *first : INT_T(~*first);
+        if (occupied == 0)
+        {
+            ++ rStats.m_wordsEmpty;
+        }
+        else if (occupied == INT_T(~INT_T(0)))
+        {
+            ++ rStats.m_wordsFull;
+        }
+        else
+        {
+            ++ rStats.m_wordsPartial;
+        }
+    }
+}
+
+/**
+ * @brief Histogram of the number of occupied bits per word of a bitset
+ *
+ * @return Array where [n] is the number of words with exactly n occupied bits
+ */
+template<bool ONES_OCCUPIED, typename INT_T>
+std::array<std::size_t, sizeof(INT_T) * 8 + 1> word_occupancy_histogram(
+        INT_T const* first, INT_T const* last) noexcept
+{
+    std::array<std::size_t, sizeof(INT_T) * 8 + 1> out{};
+    for (; first != last; ++first)
+    {
+        INT_T const occupied = ONES_OCCUPIED ? *first : INT_T(~*first);
+        ++ out[popcount(std::uint64_t(occupied))];
+    }
+    return out;
+}
+
+/**
+ * @brief Memory stats of anything with a memory_stats() member function
+ */
+template<typename CONTAINER_T>
+MemoryStats memory_stats_of(CONTAINER_T const& container)
+{
+    return container.memory_stats();
+}
+
+template<typename T, typename ALLOC_T>
+MemoryStats memory_stats_of(std::vector<T, ALLOC_T> const& vec)
+{
+    return vector_memory_stats(vec);
+}
+
+inline MemoryStats memory_stats_of(MemoryStats const& stats)
+{
+    return stats;
+}
+
+/**
+ * @brief Add together memory stats of multiple containers
+ *
+ * Accepts anything accepted by memory_stats_of(). Intended to sum up all containers of a user
+ * struct, eg: sum_memory_stats(rWorld.m_ids, rWorld.m_positions, ...)
+ */
+template<typename ... CONTAINER_T>
+MemoryStats sum_memory_stats(CONTAINER_T const& ... containers)
+{
+    MemoryStats out;
+    ( (out += memory_stats_of(containers)), ... );
+    return out;
+}
+
+} // namespace lgrn
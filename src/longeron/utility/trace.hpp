@@ -0,0 +1,49 @@
+/**
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: 2026 Neal Nicdao <chrisnicdao0@gmail.com>
+ */
+#pragma once
+
+/**
+ * Event counters and scoped trace events for measuring hot paths
+ *
+ * Enable by defining LGRN_TRACE_ENABLE (see the LONGERON_TRACE CMake option). When disabled,
+ * LGRN_TRACE and LGRN_COUNTER* compile to nothing and their arguments are not evaluated.
+ *
+ * * LGRN_COUNTER(name)         - Add 1 to a named counter
+ * * LGRN_COUNTER_ADD(name, n)  - Add n to a named counter
+ * * LGRN_TRACE(name)           - Record the duration of the current scope as an event
+ *
+ * Names must be string literals. Counters are thread-local and only summed up when read. Events
+ * are written to a per-thread ring buffer, keeping only the most recent TraceThread::smc_ringSize
+ * events of each thread. Read results with trace_counter_totals() and trace_chrome_json() from
+ * trace_recorder.hpp, which only needs to be included where results are read.
+ *
+ * Nothing beyond these macros is included unless enabled.
+ */
+#ifdef LGRN_TRACE_ENABLE
+    #include "trace_recorder.hpp"
+
+    #define _LGRN_TRACE_CAT2(a, b) a##b
+    #define _LGRN_TRACE_CAT(a, b) _LGRN_TRACE_CAT2(a, b)
+
+    #define LGRN_TRACE(name) \
+        ::lgrn::TraceScope const _LGRN_TRACE_CAT(lgrnTraceScope, __LINE__){name}
+
+    #define LGRN_COUNTER_ADD(name, n)                                   \
+        do                                                              \
+        {                                                               \
+            static ::lgrn::TraceCounter const lgrnTraceCounter{name};   \
+            lgrnTraceCounter.add(n);                                    \
+        }                                                               \
+        while (false)
+
+    // Functions using trace macros can't be constexpr
+    #define LGRN_TRACE_CONSTEXPR
+#else
+    #define LGRN_TRACE(name) ((void)0)
+    #define LGRN_COUNTER_ADD(name, n) ((void)0)
+    #define LGRN_TRACE_CONSTEXPR constexpr
+#endif
+
+#define LGRN_COUNTER(name) LGRN_COUNTER_ADD(name, 1)
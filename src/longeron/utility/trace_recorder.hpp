@@ -0,0 +1,324 @@
+/**
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: 2026 Neal Nicdao <chrisnicdao0@gmail.com>
+ */
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * Storage and export of results recorded by LGRN_TRACE and LGRN_COUNTER, see trace.hpp
+ *
+ * Usable even when tracing is disabled, in which case nothing is ever recorded.
+ */
+
+namespace lgrn
+{
+
+struct TraceEvent
+{
+    char const      *m_name;
+    std::uint64_t   m_beginNs;
+    std::uint64_t   m_endNs;
+};
+
+/**
+ * @brief Counters and events recorded by a single thread
+ */
+struct TraceThread
+{
+    static constexpr std::size_t smc_maxCounters    = 256;
+    static constexpr std::size_t smc_ringSize       = 4096;
+
+    TraceThread();
+    ~TraceThread();
+
+    // Written only by the owning thread, atomic so other threads can read them at any time
+    std::array<std::atomic<std::uint64_t>, smc_maxCounters> m_counts{};
+
+    std::array<TraceEvent, smc_ringSize>    m_events{};
+    std::size_t                             m_eventsRecorded{0};
+    std::uint32_t                           m_threadNum{0};
+};
+
+/**
+ * @brief Data shared by all threads. Only accessed when registering counters and threads, and
+ *        when reading results.
+ */
+struct TraceGlobal
+{
+    std::mutex                                          m_mutex;
+    std::vector<char const*>                            m_counterNames;
+    std::vector<TraceThread*>                           m_threads;
+
+    // Results of threads that already exited
+    std::array<std::uint64_t, TraceThread::smc_maxCounters> m_exitedCounts{};
+    std::vector< std::pair<std::uint32_t, TraceEvent> > m_exitedEvents;
+
+    std::uint32_t                                       m_nextThreadNum{0};
+    std::chrono::steady_clock::time_point const         m_start{std::chrono::steady_clock::now()};
+};
+
+inline TraceGlobal& trace_global()
+{
+    static TraceGlobal s_global;
+    return s_global;
+}
+
+inline TraceThread& trace_this_thread()
+{
+    thread_local TraceThread t_thread;
+    return t_thread;
+}
+
+inline std::uint64_t trace_now_ns() noexcept
+{
+    return std::uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - trace_global().m_start).count());
+}
+
+inline TraceThread::TraceThread()
+{
+    TraceGlobal &rGlobal = trace_global();
+    std::lock_guard<std::mutex> lock{rGlobal.m_mutex};
+    m_threadNum = rGlobal.m_nextThreadNum ++;
+    rGlobal.m_threads.push_back(this);
+}
+
+inline TraceThread::~TraceThread()
+{
+    TraceGlobal &rGlobal = trace_global();
+    std::lock_guard<std::mutex> lock{rGlobal.m_mutex};
+
+    for (std::size_t i = 0; i < smc_maxCounters; ++i)
+    {
+        rGlobal.m_exitedCounts[i] += m_counts[i].load(std::memory_order_relaxed);
+    }
+
+    std::size_t const eventCount = std::min(m_eventsRecorded, smc_ringSize);
+    for (std::size_t i = m_eventsRecorded - eventCount; i < m_eventsRecorded; ++i)
+    {
+        rGlobal.m_exitedEvents.emplace_back(m_threadNum, m_events[i % smc_ringSize]);
+    }
+
+    rGlobal.m_threads.erase(std::find(rGlobal.m_threads.begin(), rGlobal.m_threads.end(), this));
+}
+
+/**
+ * @brief A named counter, intended to be a function-local static. See LGRN_COUNTER
+ */
+class TraceCounter
+{
+public:
+    explicit TraceCounter(char const* name)
+    {
+        TraceGlobal &rGlobal = trace_global();
+        std::lock_guard<std::mutex> lock{rGlobal.m_mutex};
+
+        // Same name from different call sites shares the same counter
+        auto const found = std::find_if(rGlobal.m_counterNames.begin(), rGlobal.m_counterNames.end(),
+                                        [name] (char const* other) { return std::strcmp(name, other) == 0; });
+        m_index = std::size_t(found - rGlobal.m_counterNames.begin());
+        if (found == rGlobal.m_counterNames.end())
+        {
+            // Silently share the last counter when running out, to avoid pulling in asserts here
+            if (m_index == TraceThread::smc_maxCounters)
+            {
+                m_index = TraceThread::smc_maxCounters - 1;
+                return;
+            }
+            rGlobal.m_counterNames.push_back(name);
+        }
+    }
+
+    void add(std::uint64_t n) const noexcept
+    {
+        // Only one thread writes to this, a load and store is enough
+        std::atomic<std::uint64_t> &rCount = trace_this_thread().m_counts[m_index];
+        rCount.store(rCount.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+    }
+
+private:
+    std::size_t m_index;
+};
+
+/**
+ * @brief Records an event from construction to destruction. See LGRN_TRACE
+ */
+class TraceScope
+{
+public:
+    explicit TraceScope(char const* name) noexcept
+     : m_name{name}
+     , m_beginNs{trace_now_ns()}
+    { }
+
+    TraceScope(TraceScope const& copy) = delete;
+    TraceScope& operator=(TraceScope const& copy) = delete;
+
+    ~TraceScope()
+    {
+        TraceThread &rThread = trace_this_thread();
+        rThread.m_events[rThread.m_eventsRecorded % TraceThread::smc_ringSize]
+                = TraceEvent{m_name, m_beginNs, trace_now_ns()};
+        ++ rThread.m_eventsRecorded;
+    }
+
+private:
+    char const      *m_name;
+    std::uint64_t   m_beginNs;
+};
+
+/**
+ * @return Names and values of all counters, summed over all threads including exited ones
+ */
+inline std::vector< std::pair<char const*, std::uint64_t> > trace_counter_totals()
+{
+    TraceGlobal &rGlobal = trace_global();
+    std::lock_guard<std::mutex> lock{rGlobal.m_mutex};
+
+    std::vector< std::pair<char const*, std::uint64_t> > out;
+    out.reserve(rGlobal.m_counterNames.size());
+    for (std::size_t i = 0; i < rGlobal.m_counterNames.size(); ++i)
+    {
+        std::uint64_t total = rGlobal.m_exitedCounts[i];
+        for (TraceThread const *pThread : rGlobal.m_threads)
+        {
+            total += pThread->m_counts[i].load(std::memory_order_relaxed);
+        }
+        out.emplace_back(rGlobal.m_counterNames[i], total);
+    }
+    return out;
+}
+
+/**
+ * @brief Export recorded events and counter totals as Chrome trace event JSON, viewable in
+ *        chrome://tracing or Perfetto
+ *
+ * @warning Other threads must not be recording events while this is called, as ring buffers are
+ *          read without synchronization. Counters are safe to read at any time.
+ */
+inline std::string trace_chrome_json()
+{
+    auto const counters = trace_counter_totals();
+
+    TraceGlobal &rGlobal = trace_global();
+    std::lock_guard<std::mutex> lock{rGlobal.m_mutex};
+
+    std::string out = "{\"traceEvents\":[";
+    bool first = true;
+    char buffer[128];
+
+    auto const append_name = [&out] (char const* name)
+    {
+        out += '"';
+        for (; *name != '\0'; ++name)
+        {
+            if (*name == '"' || *name == '\\')
+            {
+                out += '\\';
+            }
+            out += *name;
+        }
+        out += '"';
+    };
+
+    auto const append_event = [&] (std::uint32_t threadNum, TraceEvent const& event)
+    {
+        out += first ? "\n{\"name\":" : ",\n{\"name\":";
+        first = false;
+        append_name(event.m_name);
+        std::snprintf(buffer, sizeof(buffer), ",\"ph\":\"X\",\"pid\":0,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+                      unsigned(threadNum), double(event.m_beginNs) / 1000.0,
+                      double(event.m_endNs - event.m_beginNs) / 1000.0);
+        out += buffer;
+    };
+
+    for (auto const& [threadNum, event] : rGlobal.m_exitedEvents)
+    {
+        append_event(threadNum, event);
+    }
+    for (TraceThread const *pThread : rGlobal.m_threads)
+    {
+        std::size_t const recorded = pThread->m_eventsRecorded;
+        std::size_t const count = std::min(recorded, TraceThread::smc_ringSize);
+        for (std::size_t i = recorded - count; i < recorded; ++i)
+        {
+            append_event(pThread->m_threadNum, pThread->m_events[i % TraceThread::smc_ringSize]);
+        }
+    }
+
+    // Counter totals as a single counter event at the end
+    if ( ! counters.empty() )
+    {
+        out += first ? "\n" : ",\n";
+        std::snprintf(buffer, sizeof(buffer), "{\"name\":\"counters\",\"ph\":\"C\",\"pid\":0,\"ts\":%.3f,\"args\":{",
+                      double(trace_now_ns()) / 1000.0);
+        out += buffer;
+        for (std::size_t i = 0; i < counters.size(); ++i)
+        {
+            if (i != 0)
+            {
+                out += ',';
+            }
+            append_name(counters[i].first);
+            std::snprintf(buffer, sizeof(buffer), ":%llu", static_cast<unsigned long long>(counters[i].second));
+            out += buffer;
+        }
+        out += "}}";
+    }
+
+    out += "\n]}\n";
+    return out;
+}
+
+/**
+ * @brief Write trace_chrome_json() to a file
+ *
+ * @return true if successful
+ */
+inline bool trace_write_chrome_json(char const* path)
+{
+    std::string const json = trace_chrome_json();
+    std::FILE *pFile = std::fopen(path, "w");
+    if (pFile == nullptr)
+    {
+        return false;
+    }
+    bool const written = std::fwrite(json.data(), 1, json.size(), pFile) == json.size();
+    return (std::fclose(pFile) == 0) && written;
+}
+
+/**
+ * @brief Clear all counters and events
+ *
+ * @warning Other threads must not be recording anything while this is called
+ */
+inline void trace_reset()
+{
+    TraceGlobal &rGlobal = trace_global();
+    std::lock_guard<std::mutex> lock{rGlobal.m_mutex};
+
+    rGlobal.m_exitedCounts.fill(0);
+    rGlobal.m_exitedEvents.clear();
+    for (TraceThread *pThread : rGlobal.m_threads)
+    {
+        for (std::atomic<std::uint64_t> &rCount : pThread->m_counts)
+        {
+            rCount.store(0, std::memory_order_relaxed);
+        }
+        pThread->m_eventsRecorded = 0;
+    }
+}
+
+} // namespace lgrn
@@ -0,0 +1,65 @@
+/**
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: 2026 Neal Nicdao <chrisnicdao0@gmail.com>
+ */
+
+// Only cheap assertions, as if running a release build with bounds checks
+#undef LGRN_ASSERT_LEVEL
+#define LGRN_ASSERT_LEVEL 1
+
+#include <longeron/utility/asserts.hpp>
+
+#include <gtest/gtest.h>
+
+enum class Id : unsigned int { };
+
+struct Vec2
+{
+    int x;
+    int y;
+};
+
+template<>
+struct lgrn::AssertPrinter<Vec2>
+{
+    static void print(std::FILE* pFile, Vec2 const& vec)
+    {
+        std::fprintf(pFile, "(%d, %d)", vec.x, vec.y);
+    }
+};
+
+struct Opaque { };
+
+TEST(Asserts, Levels)
+{
+    int evaluated = 0;
+    [[maybe_unused]] auto const count = [&evaluated] () { ++evaluated; return false; };
+
+    // Disabled levels don't evaluate their expressions
+    LGRN_ASSERTM(count(), "normal");
+    LGRN_ASSERTM_EXPENSIVE(count(), "expensive");
+    EXPECT_EQ(evaluated, 0);
+
+    LGRN_ASSERT_CHEAP(evaluated == 0);
+    LGRN_ASSERTMV_CHEAP(evaluated == 0, "passes", evaluated);
+}
+
+TEST(AssertsDeathTest, FailurePrintsVariables)
+{
+    int const bit = 70;
+    std::size_t const size = 64;
+    Id const id{42};
+
+    EXPECT_DEATH(LGRN_ASSERTMV_CHEAP(bit < size, "Bit position out of range", bit, size, id),
+                 "Bit position out of range(.|\n)*bit: 70(.|\n)*size: 64(.|\n)*id: 42");
+}
+
+// Types with an AssertPrinter print through it, others print a placeholder
+TEST(AssertsDeathTest, FailurePrintsCustom)
+{
+    Vec2 const pos{3, -4};
+    Opaque const opaque;
+
+    EXPECT_DEATH(LGRN_ASSERTMV_CHEAP(pos.x < 0, "Outside", pos, opaque),
+                 "Outside(.|\n)*pos: \\(3, -4\\)(.|\n)*opaque: \\(not printable\\)");
+}
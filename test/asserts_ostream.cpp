@@ -0,0 +1,38 @@
+/**
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: 2026 Neal Nicdao <chrisnicdao0@gmail.com>
+ */
+
+// Defined for this whole test executable, see test/CMakeLists.txt
+#ifndef LGRN_ASSERT_OSTREAM
+    #error "LGRN_ASSERT_OSTREAM must be defined project-wide"
+#endif
+
+#include <longeron/utility/asserts.hpp>
+
+#include <gtest/gtest.h>
+
+#include <ostream>
+
+struct Vec2
+{
+    int x;
+    int y;
+};
+
+std::ostream& operator<<(std::ostream& rStream, Vec2 const& vec)
+{
+    return rStream << "(" << vec.x << ", " << vec.y << ")";
+}
+
+struct Opaque { };
+
+// Types with an operator<< print through it, others still print a placeholder
+TEST(AssertsOstreamDeathTest, FailurePrintsStreamable)
+{
+    Vec2 const pos{3, -4};
+    Opaque const opaque;
+
+    EXPECT_DEATH(LGRN_ASSERTMV(pos.x < 0, "Outside", pos, opaque),
+                 "Outside(.|\n)*pos: \\(3, -4\\)(.|\n)*opaque: \\(not printable\\)");
+}
@@ -0,0 +1,101 @@
+/**
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: 2026 Neal Nicdao <chrisnicdao0@gmail.com>
+ */
+#include <longeron/containers/bit_matrix.hpp>
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+TEST(BitMatrix, Transpose64x64)
+{
+    std::mt19937_64 gen(69);
+    std::uint64_t original[64];
+    std::uint64_t block[64];
+    for (std::size_t i = 0; i < 64; ++i)
+    {
+        original[i] = block[i] = gen();
+    }
+
+    lgrn::transpose_64x64(block);
+    for (std::size_t row = 0; row < 64; ++row)
+    {
+        for (std::size_t col = 0; col < 64; ++col)
+        {
+            ASSERT_EQ((original[row] >> col) & 1u, (block[col] >> row) & 1u);
+        }
+    }
+
+    lgrn::transpose_64x64(block);
+    EXPECT_TRUE(std::equal(block, block + 64, original));
+}
+
+TEST(BitMatrix, RowOperations)
+{
+    lgrn::BitMatrix mat{4, 100};
+    ASSERT_EQ(mat.row_words(), 2);
+
+    mat.set(0, 1);
+    mat.set(0, 99);
+    mat.set(1, 1);
+    mat.set(1, 70);
+    mat.set(2, 50);
+
+    EXPECT_EQ(mat.row_count(0), 2);
+    EXPECT_TRUE(mat.row(0).test(99));
+    EXPECT_EQ(mat.row(1).count(), 2);
+
+    mat.row_or(3, 0);
+    mat.row_or(3, 2);
+    EXPECT_EQ(mat.row_count(3), 3);
+
+    mat.row_and(3, 1);
+    EXPECT_EQ(mat.row_count(3), 1);
+    EXPECT_TRUE(mat.test(3, 1));
+
+    // Rows that share any bit with row 1 (bits 1 and 70)
+    std::vector<std::size_t> hits;
+    mat.for_each_row_intersecting(mat.row_data(1), [&hits] (std::size_t row) { hits.push_back(row); });
+    EXPECT_EQ(hits, (std::vector<std::size_t>{0, 1, 3}));
+    EXPECT_FALSE(mat.row_intersects(2, mat.row_data(1)));
+
+    mat.reset(0, 1);
+    EXPECT_FALSE(mat.test(0, 1));
+}
+
+// Transposing non-multiple-of-64 sizes, compared against testing each bit
+TEST(BitMatrix, Transposed)
+{
+    std::mt19937 gen(420);
+    lgrn::BitMatrix mat{150, 77};
+    for (std::size_t row = 0; row < mat.rows(); ++row)
+    {
+        for (std::size_t col = 0; col < mat.cols(); ++col)
+        {
+            if (gen() % 3 == 0)
+            {
+                mat.set(row, col);
+            }
+        }
+    }
+
+    lgrn::BitMatrix const tr = mat.transposed();
+    ASSERT_EQ(tr.rows(), 77);
+    ASSERT_EQ(tr.cols(), 150);
+
+    std::vector<std::uint64_t> column(tr.row_words());
+    for (std::size_t col = 0; col < mat.cols(); ++col)
+    {
+        mat.column(col, column.data());
+        for (std::size_t row = 0; row < mat.rows(); ++row)
+        {
+            ASSERT_EQ(mat.test(row, col), tr.test(col, row));
+            ASSERT_EQ(mat.test(row, col), lgrn::bit_test(column[row / 64], row % 64));
+        }
+        EXPECT_TRUE(std::equal(column.begin(), column.end(), tr.row_data(col)));
+    }
+
+    EXPECT_EQ(tr.transposed().memory_stats().m_wordsFull, mat.memory_stats().m_wordsFull);
+}
@@ -0,0 +1,69 @@
+/**
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: 2026 Neal Nicdao <chrisnicdao0@gmail.com>
+ */
+#include <longeron/containers/double_buffered.hpp>
+
+#include <gtest/gtest.h>
+
+enum class Id : uint64_t { };
+
+// Write next values to the back while reading the front, then swap and sync
+TEST(DoubleBuffered, KeyedVec)
+{
+    lgrn::DoubleBuffered< lgrn::KeyedVec<Id, int> > values;
+    values.for_both([] (lgrn::KeyedVec<Id, int> &rVec) { rVec.resize(200, 0); });
+
+    lgrn::IdSetStl<Id> dirty;
+    dirty.resize(200);
+
+    for (int step = 1; step <= 3; ++step)
+    {
+        // Each step, change a few values based on the previous step
+        for (Id const id : {Id{3}, Id{64}, Id{150}})
+        {
+            values.back()[id] = values.front()[id] + step;
+            dirty.insert(id);
+        }
+
+        // Front is unaffected until swapped
+        EXPECT_EQ(values.front()[Id{3}], (step - 1) * step / 2);
+
+        int const *pOldBack = values.back().data();
+        values.swap_and_sync(dirty);
+        dirty.clear();
+
+        EXPECT_EQ(values.front().data(), pOldBack);
+        EXPECT_EQ(values.front()[Id{3}], step * (step + 1) / 2);
+        EXPECT_EQ(values.front().base(), values.back().base());
+    }
+    EXPECT_EQ(values.front()[Id{64}], 6);
+    EXPECT_EQ(values.front()[Id{150}], 6);
+    EXPECT_EQ(values.front()[Id{0}], 0);
+}
+
+TEST(DoubleBuffered, IdSet)
+{
+    lgrn::DoubleBuffered< lgrn::IdSetStl<Id> > sets;
+    sets.for_both([] (lgrn::IdSetStl<Id> &rSet) { rSet.resize(300); });
+
+    lgrn::IdSetStl<Id> dirty;
+    dirty.resize(300);
+
+    sets.back().insert({Id{1}, Id{100}, Id{299}});
+    dirty.insert({Id{1}, Id{100}, Id{299}});
+    sets.swap_and_sync(dirty);
+    dirty.clear();
+
+    EXPECT_TRUE(sets.front().contains(Id{100}));
+    EXPECT_EQ(sets.front().vec(), sets.back().vec());
+
+    sets.back().erase(Id{100});
+    dirty.insert(Id{100});
+    sets.swap_and_sync(dirty);
+
+    EXPECT_FALSE(sets.front().contains(Id{100}));
+    EXPECT_TRUE(sets.front().contains(Id{299}));
+    EXPECT_EQ(sets.front().vec(), sets.back().vec());
+    EXPECT_EQ(sets.memory_stats().m_bytesUsed, sets.front().memory_stats().m_bytesUsed * 2);
+}
@@ -0,0 +1,144 @@
+/**
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: 2026 Neal Nicdao <chrisnicdao0@gmail.com>
+ */
+#include <longeron/containers/event_stream.hpp>
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+struct Event
+{
+    int m_thread;
+    int m_value;
+};
+
+// Events written from many threads at once are all readable afterwards
+TEST(EventStream, ParallelWrite)
+{
+    constexpr int threadCount = 8;
+    constexpr int perThread   = 10000;
+
+    lgrn::EventStream<Event, 64> stream;
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadCount; ++t)
+    {
+        threads.emplace_back([&stream, t] ()
+        {
+            auto writer = stream.writer();
+            for (int i = 0; i < perThread; ++i)
+            {
+                writer.push({t, i});
+            }
+        });
+    }
+    for (std::thread &rThread : threads)
+    {
+        rThread.join();
+    }
+
+    auto const view = stream.view();
+    ASSERT_EQ(view.size(), threadCount * perThread);
+    EXPECT_EQ(stream.size(), view.size());
+
+    // Order is kept per-thread
+    std::vector<int> nextValue(threadCount, 0);
+    std::size_t count = 0;
+    for (Event const& event : view)
+    {
+        EXPECT_EQ(event.m_value, nextValue[event.m_thread]);
+        ++ nextValue[event.m_thread];
+        ++ count;
+    }
+    EXPECT_EQ(count, view.size());
+
+    std::size_t chunkTotal = 0;
+    for (auto const& chunk : view.chunks())
+    {
+        EXPECT_LE(chunk.size(), 64);
+        chunkTotal += chunk.size();
+    }
+    EXPECT_EQ(chunkTotal, view.size());
+}
+
+// Events don't move once written, even as more are added
+TEST(EventStream, StableAddresses)
+{
+    lgrn::EventStream<int, 4> stream;
+    auto writer = stream.writer();
+
+    int const *pFirst = &writer.push(42);
+    for (int i = 0; i < 100; ++i)
+    {
+        writer.push(i);
+    }
+    EXPECT_EQ(*pFirst, 42);
+    EXPECT_EQ(&*stream.view().begin(), pFirst);
+}
+
+// reset() reuses chunks instead of allocating new ones
+TEST(EventStream, ResetRecyclesChunks)
+{
+    lgrn::EventStream<int, 16> stream;
+
+    auto const write_frame = [&stream] ()
+    {
+        auto writerA = stream.writer();
+        auto writerB = stream.writer();
+        for (int i = 0; i < 100; ++i)
+        {
+            writerA.push(i);
+            writerB.push(-i);
+        }
+    };
+
+    write_frame();
+    std::size_t const reserved = stream.memory_stats().m_bytesReserved;
+    EXPECT_EQ(stream.size(), 200);
+
+    for (int frame = 0; frame < 10; ++frame)
+    {
+        stream.reset();
+        EXPECT_EQ(stream.size(), 0);
+        EXPECT_TRUE(stream.view().empty());
+        EXPECT_EQ(stream.view().begin(), stream.view().end());
+
+        write_frame();
+        EXPECT_EQ(stream.size(), 200);
+        EXPECT_EQ(stream.memory_stats().m_bytesReserved, reserved);
+    }
+
+    stream.reset();
+    stream.shrink_to_fit();
+    EXPECT_EQ(stream.memory_stats().m_bytesReserved, 0);
+}
+
+// Non-trivial events are destroyed on reset and destruction
+TEST(EventStream, DestroysEvents)
+{
+    auto const tracker = std::make_shared<int>(0);
+    {
+        lgrn::EventStream<std::shared_ptr<int>, 8> stream;
+        {
+            auto writer = stream.writer();
+            for (int i = 0; i < 20; ++i)
+            {
+                writer.push(tracker);
+            }
+        }
+        EXPECT_EQ(tracker.use_count(), 21);
+
+        stream.reset();
+        EXPECT_EQ(tracker.use_count(), 1);
+
+        auto writer = stream.writer();
+        writer.push(tracker);
+        writer = {};
+        EXPECT_EQ(tracker.use_count(), 2);
+    }
+    EXPECT_EQ(tracker.use_count(), 1);
+}
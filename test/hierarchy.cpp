@@ -0,0 +1,184 @@
+/**
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: 2026 Neal Nicdao <chrisnicdao0@gmail.com>
+ */
+#include <longeron/containers/hierarchy.hpp>
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+enum class Id : uint32_t { };
+
+using Hierarchy_t = lgrn::Hierarchy<Id>;
+
+static constexpr Id const gc_null = lgrn::id_null<Id>();
+
+/**
+ * @brief Check that the depth-first layout agrees with each node's parent
+ */
+static void check_layout(Hierarchy_t const& hier)
+{
+    std::vector<Id> const order(hier.dfs().begin(), hier.dfs().end());
+    ASSERT_EQ(order.size(), hier.size());
+
+    for (std::size_t pos = 0; pos < order.size(); ++pos)
+    {
+        Id const id = order[pos];
+        ASSERT_EQ(hier.position(id), pos);
+
+        Id const parent = hier.parent(id);
+        if (parent == gc_null)
+        {
+            ASSERT_EQ(hier.depth(id), 0);
+        }
+        else
+        {
+            // Parent comes first, and its subtree contains this whole subtree
+            std::size_t const parentPos = hier.position(parent);
+            ASSERT_LT(parentPos, pos);
+            ASSERT_LE(pos + hier.descendant_count(id), parentPos + hier.descendant_count(parent));
+            ASSERT_EQ(hier.depth(id), hier.depth(parent) + 1);
+        }
+
+        // Descendant count matches the number of nodes whose ancestor chain contains this node
+        std::size_t descendants = 0;
+        for (Id const other : order)
+        {
+            for (Id anc = hier.parent(other); anc != gc_null; anc = hier.parent(anc))
+            {
+                if (anc == id)
+                {
+                    ++ descendants;
+                    break;
+                }
+            }
+        }
+        ASSERT_EQ(hier.descendant_count(id), descendants);
+    }
+}
+
+TEST(Hierarchy, BasicUse)
+{
+    Hierarchy_t hier;
+    hier.ids_reserve(16);
+
+    //  0         5
+    //  ├─1       └─6
+    //  │ └─2
+    //  └─3
+    //    └─4
+    hier.insert(Id{0});
+    hier.insert(Id{1}, Id{0});
+    hier.insert(Id{3}, Id{0});
+    hier.insert(Id{2}, Id{1});
+    hier.insert(Id{4}, Id{3});
+    hier.insert(Id{5});
+    hier.insert(Id{6}, Id{5});
+
+    EXPECT_EQ(std::vector<Id>(hier.dfs().begin(), hier.dfs().end()),
+              (std::vector<Id>{Id{0}, Id{1}, Id{2}, Id{3}, Id{4}, Id{5}, Id{6}}));
+    EXPECT_EQ(hier.subtree(Id{3}).size(), 2);
+    check_layout(hier);
+
+    std::vector<Id> children;
+    hier.for_each_child(Id{0}, [&children] (Id child) { children.push_back(child); });
+    EXPECT_EQ(children, (std::vector<Id>{Id{1}, Id{3}}));
+
+    children.clear();
+    hier.for_each_child(gc_null, [&children] (Id child) { children.push_back(child); });
+    EXPECT_EQ(children, (std::vector<Id>{Id{0}, Id{5}}));
+
+    hier.update_levels();
+    ASSERT_EQ(hier.level_count(), 3);
+    EXPECT_EQ(std::vector<Id>(hier.level(0).begin(), hier.level(0).end()), (std::vector<Id>{Id{0}, Id{5}}));
+    EXPECT_EQ(std::vector<Id>(hier.level(1).begin(), hier.level(1).end()), (std::vector<Id>{Id{1}, Id{3}, Id{6}}));
+    EXPECT_EQ(std::vector<Id>(hier.level(2).begin(), hier.level(2).end()), (std::vector<Id>{Id{2}, Id{4}}));
+
+    // Move 1 (and 2) under 6, forwards
+    hier.reparent(Id{1}, Id{6});
+    EXPECT_EQ(std::vector<Id>(hier.dfs().begin(), hier.dfs().end()),
+              (std::vector<Id>{Id{0}, Id{3}, Id{4}, Id{5}, Id{6}, Id{1}, Id{2}}));
+    EXPECT_EQ(hier.depth(Id{2}), 3);
+    check_layout(hier);
+
+    // Move 6 under 0, backwards
+    hier.reparent(Id{6}, Id{0});
+    EXPECT_EQ(std::vector<Id>(hier.dfs().begin(), hier.dfs().end()),
+              (std::vector<Id>{Id{0}, Id{3}, Id{4}, Id{6}, Id{1}, Id{2}, Id{5}}));
+    check_layout(hier);
+
+    hier.remove(Id{6});
+    EXPECT_FALSE(hier.contains(Id{1}));
+    EXPECT_FALSE(hier.contains(Id{2}));
+    EXPECT_EQ(hier.size(), 4);
+    check_layout(hier);
+}
+
+// Random inserts, removes, and reparents always keep a valid layout
+TEST(Hierarchy, Randomized)
+{
+    constexpr std::size_t idCount = 200;
+
+    std::mt19937 gen(69);
+    Hierarchy_t hier;
+    hier.ids_reserve(idCount);
+
+    auto const random_existing = [&gen, &hier] () -> Id
+    {
+        std::uniform_int_distribution<std::size_t> pick(0, hier.size() - 1);
+        return *(hier.dfs().begin() + pick(gen));
+    };
+
+    for (int i = 0; i < 2000; ++i)
+    {
+        Id const id{ std::uint32_t(gen() % idCount) };
+        int const op = gen() % 4;
+
+        if ( ! hier.contains(id) )
+        {
+            Id const parent = (hier.size() == 0 || op == 0) ? gc_null : random_existing();
+            hier.insert(id, parent);
+        }
+        else if (op == 0)
+        {
+            hier.remove(id);
+        }
+        else
+        {
+            Id const newParent = (op == 1) ? gc_null : random_existing();
+            std::size_t const pos = hier.position(id);
+            bool const isOwnSubtree = newParent != gc_null
+                                   && hier.position(newParent) >= pos
+                                   && hier.position(newParent) <= pos + hier.descendant_count(id);
+            if ( ! isOwnSubtree )
+            {
+                hier.reparent(id, newParent);
+            }
+        }
+
+        if (i % 50 == 0)
+        {
+            check_layout(hier);
+            if (HasFatalFailure())
+            {
+                return;
+            }
+        }
+    }
+    check_layout(hier);
+
+    // Every node appears in the level of its depth
+    hier.update_levels();
+    std::size_t total = 0;
+    for (std::size_t depth = 0; depth < hier.level_count(); ++depth)
+    {
+        for (Id const id : hier.level(depth))
+        {
+            EXPECT_EQ(hier.depth(id), depth);
+            ++ total;
+        }
+    }
+    EXPECT_EQ(total, hier.size());
+}
@@ -0,0 +1,104 @@
+/**
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: 2026 Neal Nicdao <chrisnicdao0@gmail.com>
+ */
+#include <longeron/id_management/id_hash_map.hpp>
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <string>
+#include <unordered_map>
+
+enum class Id : uint32_t { };
+
+TEST(IdHashMap, BasicUse)
+{
+    lgrn::IdHashMap<Id, std::string> map;
+
+    EXPECT_TRUE(map.empty());
+    EXPECT_EQ(map.find(Id{5}), nullptr);
+    EXPECT_FALSE(map.erase(Id{5}));
+
+    EXPECT_TRUE(map.emplace(Id{5}, "five").second);
+    EXPECT_FALSE(map.emplace(Id{5}, "not five").second);
+    map[Id{4000000000}] = "big";
+    map.insert_or_assign(Id{7}, "seven");
+    map.insert_or_assign(Id{7}, "SEVEN");
+
+    ASSERT_EQ(map.size(), 3);
+    EXPECT_EQ(map.at(Id{5}), "five");
+    EXPECT_EQ(map.at(Id{4000000000}), "big");
+    EXPECT_EQ(map.at(Id{7}), "SEVEN");
+
+    // Dense storage is in insertion order
+    EXPECT_EQ(std::vector<Id>(map.keys().begin(), map.keys().end()),
+              (std::vector<Id>{Id{5}, Id{4000000000}, Id{7}}));
+
+    EXPECT_TRUE(map.erase(Id{5}));
+    EXPECT_FALSE(map.contains(Id{5}));
+    EXPECT_EQ(map.at(Id{7}), "SEVEN");
+    EXPECT_EQ(map.size(), 2);
+
+    std::size_t count = 0;
+    map.for_each([&count] (Id key, std::string const& value)
+    {
+        EXPECT_EQ(value, (key == Id{7}) ? "SEVEN" : "big");
+        ++ count;
+    });
+    EXPECT_EQ(count, 2);
+
+    map.clear();
+    EXPECT_TRUE(map.empty());
+    EXPECT_FALSE(map.contains(Id{7}));
+}
+
+// Compare against std::unordered_map with random sparse keys
+TEST(IdHashMap, Randomized)
+{
+    std::mt19937 gen(69);
+
+    lgrn::IdHashMap<Id, int> map;
+    std::unordered_map<std::uint32_t, int> expect;
+
+    // Small range to get plenty of collisions and erasures, and some keys spread across 32 bits
+    auto const random_key = [&gen] () -> std::uint32_t
+    {
+        return (gen() % 4 == 0) ? (gen() % 0xFFFFFFFEu) : (gen() % 3000);
+    };
+
+    for (int i = 0; i < 50000; ++i)
+    {
+        std::uint32_t const key = random_key();
+        if (gen() % 3 == 0)
+        {
+            EXPECT_EQ(map.erase(Id{key}), expect.erase(key) == 1);
+        }
+        else
+        {
+            int const value = int(gen());
+            map.insert_or_assign(Id{key}, value);
+            expect[key] = value;
+        }
+    }
+
+    ASSERT_EQ(map.size(), expect.size());
+    for (auto const& [key, value] : expect)
+    {
+        int const *pValue = map.find(Id{key});
+        ASSERT_NE(pValue, nullptr);
+        EXPECT_EQ(*pValue, value);
+    }
+    for (std::uint32_t key = 0; key < 3000; ++key)
+    {
+        EXPECT_EQ(map.contains(Id{key}), expect.count(key) == 1);
+    }
+
+    std::size_t count = 0;
+    map.for_each([&expect, &count] (Id key, int value)
+    {
+        EXPECT_EQ(expect.at(std::uint32_t(key)), value);
+        ++ count;
+    });
+    EXPECT_EQ(count, expect.size());
+}
@@ -0,0 +1,238 @@
+/**
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: 2026 Neal Nicdao <chrisnicdao0@gmail.com>
+ */
+#include <longeron/id_management/id_name_table.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <string>
+
+enum class Id : uint32_t { };
+
+static constexpr Id const gc_null = lgrn::id_null<Id>();
+
+TEST(IdNameTable, BasicUse)
+{
+    lgrn::IdNameTable<Id> table;
+    table.ids_reserve(10);
+
+    EXPECT_EQ(table.find("nothing"), gc_null);
+
+    EXPECT_TRUE(table.assign(Id{1}, "clock"));
+    EXPECT_TRUE(table.assign(Id{4}, "reset"));
+    EXPECT_TRUE(table.assign(Id{7}, ""));
+
+    EXPECT_EQ(table.find("clock"), Id{1});
+    EXPECT_EQ(table.find("reset"), Id{4});
+    EXPECT_EQ(table.find(""), Id{7});
+    EXPECT_EQ(table.find("clk"), gc_null);
+    EXPECT_EQ(table.name(Id{4}), "reset");
+    EXPECT_EQ(table.name(Id{2}), "");
+    EXPECT_FALSE(table.contains(Id{2}));
+    EXPECT_EQ(table.size(), 3);
+
+    // Names are unique
+    EXPECT_FALSE(table.assign(Id{2}, "clock"));
+    EXPECT_TRUE(table.assign(Id{1}, "clock"));
+
+    // Renaming
+    EXPECT_TRUE(table.assign(Id{1}, "clk"));
+    EXPECT_EQ(table.find("clock"), gc_null);
+    EXPECT_EQ(table.find("clk"), Id{1});
+    EXPECT_EQ(table.size(), 3);
+
+    table.erase(Id{4});
+    EXPECT_EQ(table.find("reset"), gc_null);
+    EXPECT_FALSE(table.contains(Id{4}));
+    EXPECT_EQ(table.size(), 2);
+}
+
+// Many names, with removals to exercise backward-shift deletion
+TEST(IdNameTable, ManyNames)
+{
+    constexpr std::uint32_t count = 5000;
+
+    lgrn::IdNameTable<Id> table;
+    table.ids_reserve(count);
+
+    for (std::uint32_t i = 0; i < count; ++i)
+    {
+        ASSERT_TRUE(table.assign(Id{i}, "node_" + std::to_string(i)));
+    }
+    for (std::uint32_t i = 0; i < count; i += 3)
+    {
+        table.erase(Id{i});
+    }
+    for (std::uint32_t i = 0; i < count; ++i)
+    {
+        std::string const str = "node_" + std::to_string(i);
+        ASSERT_EQ(table.find(str), (i % 3 == 0) ? gc_null : Id{i});
+    }
+    EXPECT_EQ(table.size(), count - (count + 2) / 3);
+}
+
+// Serialized tables can be loaded back, or used in-place
+TEST(IdNameTable, Serialize)
+{
+    lgrn::IdNameTable<Id> table;
+    table.ids_reserve(100);
+    for (std::uint32_t i = 0; i < 100; i += 2)
+    {
+        table.assign(Id{i}, "gate" + std::to_string(i));
+    }
+
+    std::vector<std::byte> const blob = table.serialize();
+
+    lgrn::IdNameTableView<Id> view;
+    ASSERT_TRUE(view.attach(blob.data(), blob.size()));
+    EXPECT_EQ(view.find("gate42"), Id{42});
+    EXPECT_EQ(view.find("gate43"), gc_null);
+    EXPECT_EQ(view.name(Id{98}), "gate98");
+    EXPECT_EQ(view.name(Id{99}), "");
+
+    lgrn::IdNameTable<Id> loaded;
+    ASSERT_TRUE(loaded.deserialize(blob.data(), blob.size()));
+    EXPECT_EQ(loaded.size(), 50);
+    EXPECT_EQ(loaded.find("gate10"), Id{10});
+    EXPECT_TRUE(loaded.assign(Id{1}, "extra"));
+    EXPECT_EQ(loaded.find("extra"), Id{1});
+
+    // Truncated or corrupt blobs are rejected
+    EXPECT_FALSE(view.attach(blob.data(), blob.size() - 1));
+    std::vector<std::byte> corrupt = blob;
+    corrupt[0] = std::byte{0};
+    EXPECT_FALSE(loaded.deserialize(corrupt.data(), corrupt.size()));
+    EXPECT_EQ(loaded.size(), 51);
+}
+
+// Blobs with valid magic and size, but bad contents are rejected
+TEST(IdNameTable, CorruptBlob)
+{
+    using Layout_t = lgrn::IdNameTableLayout<Id>;
+    using Header_t = Layout_t::Header;
+
+    lgrn::IdNameTable<Id> table;
+    table.ids_reserve(8);
+    table.assign(Id{0}, "foo");
+    table.assign(Id{3}, "bar");
+
+    std::vector<std::byte> const blob = table.serialize();
+    Header_t header;
+    std::memcpy(&header, blob.data(), sizeof(Header_t));
+
+    lgrn::IdNameTableView<Id> view;
+    ASSERT_TRUE(view.attach(blob.data(), blob.size()));
+
+    auto const expect_rejected = [&blob] (auto&& modify)
+    {
+        std::vector<std::byte> corrupt = blob;
+        modify(corrupt.data());
+        lgrn::IdNameTableView<Id> corruptView;
+        lgrn::IdNameTable<Id> corruptTable;
+        EXPECT_FALSE(corruptView.attach(corrupt.data(), corrupt.size()));
+        EXPECT_FALSE(corruptTable.deserialize(corrupt.data(), corrupt.size()));
+    };
+
+    auto const patch_header = [] (std::byte* pBlob, auto&& modify)
+    {
+        Header_t header;
+        std::memcpy(&header, pBlob, sizeof(Header_t));
+        modify(header);
+        std::memcpy(pBlob, &header, sizeof(Header_t));
+    };
+
+    std::size_t const slotsOffset   = sizeof(Header_t);
+    std::size_t const entriesOffset = slotsOffset + header.m_slotCount * sizeof(Layout_t::Slot);
+
+    auto const patch_first_slot = [&header, slotsOffset] (std::byte* pBlob, std::uint32_t id)
+    {
+        for (std::size_t i = 0; i < header.m_slotCount; ++i)
+        {
+            Layout_t::Slot slot;
+            std::memcpy(&slot, pBlob + slotsOffset + i * sizeof(slot), sizeof(slot));
+            if (slot.m_id != Layout_t::smc_emptySlot)
+            {
+                slot.m_id = id;
+                std::memcpy(pBlob + slotsOffset + i * sizeof(slot), &slot, sizeof(slot));
+                return;
+            }
+        }
+    };
+
+    // Slot count not a power of two
+    expect_rejected([&] (std::byte* p) { patch_header(p, [] (Header_t& h) { h.m_slotCount -= 1; }); });
+
+    // Sizes that overflow when added up
+    expect_rejected([&] (std::byte* p) { patch_header(p, [] (Header_t& h) { h.m_arenaSize = ~std::uint64_t(0); }); });
+    expect_rejected([&] (std::byte* p) { patch_header(p, [] (Header_t& h) { h.m_entryCount = ~std::uint64_t(0) / 8 + 1; }); });
+
+    // Entry pointing outside the arena
+    expect_rejected([&] (std::byte* p)
+    {
+        Layout_t::Entry const entry{0, std::uint32_t(header.m_arenaSize + 1)};
+        std::memcpy(p + entriesOffset, &entry, sizeof(entry));
+    });
+
+    // Slot with an out of range ID, or an ID with no name (ID 1)
+    expect_rejected([&] (std::byte* p) { patch_first_slot(p, std::uint32_t(header.m_entryCount)); });
+    expect_rejected([&] (std::byte* p) { patch_first_slot(p, 1); });
+
+    // No empty slots, probing would never end
+    expect_rejected([&] (std::byte* p)
+    {
+        for (std::size_t i = 0; i < header.m_slotCount; ++i)
+        {
+            Layout_t::Slot const slot{0, 0};
+            std::memcpy(p + slotsOffset + i * sizeof(slot), &slot, sizeof(slot));
+        }
+    });
+
+    // Names with no slots at all, probing would use a mask of all bits
+    {
+        Header_t empty = header;
+        empty.m_slotCount = 0;
+        std::vector<std::byte> corrupt(blob.size() - header.m_slotCount * sizeof(Layout_t::Slot));
+        std::memcpy(corrupt.data(), &empty, sizeof(Header_t));
+        std::memcpy(corrupt.data() + sizeof(Header_t), blob.data() + entriesOffset,
+                    blob.size() - entriesOffset);
+
+        lgrn::IdNameTableView<Id> corruptView;
+        lgrn::IdNameTable<Id> corruptTable;
+        EXPECT_FALSE(corruptView.attach(corrupt.data(), corrupt.size()));
+        EXPECT_FALSE(corruptTable.deserialize(corrupt.data(), corrupt.size()));
+    }
+
+    // Two slots with the same ID. One empty slot is taken, so "bar" (ID 3) is left without one.
+    expect_rejected([&] (std::byte* p)
+    {
+        for (std::size_t i = 0; i < header.m_slotCount; ++i)
+        {
+            Layout_t::Slot slot;
+            std::memcpy(&slot, p + slotsOffset + i * sizeof(slot), sizeof(slot));
+            if (slot.m_id == 3)
+            {
+                slot.m_id = 0;
+                slot.m_hash = Layout_t::hash("foo");
+                std::memcpy(p + slotsOffset + i * sizeof(slot), &slot, sizeof(slot));
+            }
+        }
+    });
+
+    // Same as above, but keeping a slot for every name
+    expect_rejected([&] (std::byte* p)
+    {
+        for (std::size_t i = 0; i < header.m_slotCount; ++i)
+        {
+            Layout_t::Slot slot;
+            std::memcpy(&slot, p + slotsOffset + i * sizeof(slot), sizeof(slot));
+            if (slot.m_id == Layout_t::smc_emptySlot)
+            {
+                slot = {Layout_t::hash("foo"), 0};
+                std::memcpy(p + slotsOffset + i * sizeof(slot), &slot, sizeof(slot));
+                return;
+            }
+        }
+    });
+}
@@ -0,0 +1,71 @@
+/**
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: 2026 Neal Nicdao <chrisnicdao0@gmail.com>
+ */
+#include <longeron/id_management/keyed_vec_versioned.hpp>
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+enum class Id : uint64_t { };
+
+// A system only sees blocks written to after its last snapshot
+TEST(VersionedKeyedVec, ChangedSince)
+{
+    lgrn::VersionedKeyedVec<Id, int> vec;
+    vec.resize(10000, 0);
+
+    using Version_t = lgrn::VersionedKeyedVec<Id, int>::Version_t;
+    Version_t systemSeen = 0;
+
+    auto const changed_blocks = [&vec] (Version_t since)
+    {
+        std::vector<std::size_t> out;
+        vec.for_each_changed_block(since, [&out] (Id first, Id last)
+        {
+            EXPECT_LE(std::size_t(last) - std::size_t(first), 64);
+            out.push_back(std::size_t(first) / 64);
+        });
+        return out;
+    };
+
+    EXPECT_FALSE(vec.any_changed_since(systemSeen));
+    EXPECT_TRUE(changed_blocks(systemSeen).empty());
+
+    vec.write(Id{5}) = 1;
+    vec.write(Id{70}) = 2;
+    vec.write(Id{9999}) = 3;
+    EXPECT_EQ(vec[Id{70}], 2);
+
+    EXPECT_TRUE(vec.any_changed_since(systemSeen));
+    EXPECT_EQ(changed_blocks(systemSeen), (std::vector<std::size_t>{0, 1, 156}));
+
+    // System runs, then only sees writes made afterwards
+    systemSeen = vec.snapshot_version();
+    EXPECT_FALSE(vec.any_changed_since(systemSeen));
+
+    vec.write(Id{4200}) = 4;
+    EXPECT_EQ(changed_blocks(systemSeen), (std::vector<std::size_t>{65}));
+
+    std::size_t idCount = 0;
+    vec.for_each_changed(systemSeen, [&idCount] (Id id)
+    {
+        EXPECT_EQ(std::size_t(id) / 64, 65);
+        ++ idCount;
+    });
+    EXPECT_EQ(idCount, 64);
+
+    // Last block is partial, 10000 % 64 = 16
+    Version_t const beforeLast = vec.snapshot_version();
+    vec.write(Id{9990}) = 5;
+    vec.for_each_changed_block(beforeLast, [] (Id first, Id last)
+    {
+        EXPECT_EQ(std::size_t(first), 9984);
+        EXPECT_EQ(std::size_t(last), 10000);
+    });
+
+    Version_t const beforeAll = vec.snapshot_version();
+    vec.mark_all_changed();
+    EXPECT_EQ(changed_blocks(beforeAll).size(), vec.block_count());
+}
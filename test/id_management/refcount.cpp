@@ -0,0 +1,196 @@
+/**
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: 2026 Neal Nicdao <chrisnicdao0@gmail.com>
+ */
+#include <longeron/id_management/refcount.hpp>
+#include <longeron/id_management/refcount_atomic.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+enum class Id : uint32_t { };
+
+TEST(IdRefCount, BasicUse)
+{
+    using RefCount_t = lgrn::IdRefCount<Id>;
+    RefCount_t refCounts;
+
+    RefCount_t::Owner_t ownerA = refCounts.ref_add(Id{42});
+    RefCount_t::Owner_t ownerB = refCounts.ref_add(Id{42});
+
+    ASSERT_TRUE(ownerA.has_value());
+    ASSERT_EQ(ownerA.value(), Id{42});
+    ASSERT_EQ(refCounts[42], 2);
+
+    refCounts.ref_release(std::move(ownerA));
+    EXPECT_FALSE(ownerA.has_value());
+    EXPECT_EQ(refCounts[42], 1);
+
+    refCounts.ref_release(std::move(ownerB));
+    EXPECT_EQ(refCounts[42], 0);
+    EXPECT_TRUE(refCounts.only_zeros_remaining(0));
+}
+
+// Collect IDs that become unreferenced, as if destroying their resources in a batch
+TEST(IdRefCount, Zeros)
+{
+    using RefCount_t = lgrn::IdRefCount<Id>;
+    RefCount_t refCounts;
+
+    std::vector<RefCount_t::Owner_t> owners;
+    for (uint32_t id = 0; id < 200; ++id)
+    {
+        owners.push_back(refCounts.ref_add(Id(id)));
+    }
+
+    ASSERT_TRUE(refCounts.zeros().empty());
+
+    refCounts.ref_release(std::move(owners[3]));
+    refCounts.ref_release(std::move(owners[150]));
+    refCounts.ref_release(std::move(owners[7]));
+
+    // 7 is referenced again, and is no longer a zero
+    RefCount_t::Owner_t ownerC = refCounts.ref_add(Id{7});
+
+    auto const expected = {Id{3}, Id{150}};
+    ASSERT_EQ(refCounts.zeros().size(), 2);
+    EXPECT_TRUE(std::equal(expected.begin(), expected.end(), refCounts.zeros().begin()));
+
+    refCounts.clear_zeros();
+    EXPECT_TRUE(refCounts.zeros().empty());
+
+    refCounts.ref_release(std::move(ownerC));
+    for (RefCount_t::Owner_t &rOwner : owners)
+    {
+        refCounts.ref_release(std::move(rOwner));
+    }
+
+    EXPECT_EQ(refCounts.zeros().size(), 198);
+    EXPECT_TRUE(refCounts.only_zeros_remaining(0));
+}
+
+// Single byte counts that spill into a hash map when they get too large
+TEST(IdRefCount, Compact)
+{
+    using RefCount_t = lgrn::IdRefCount<Id, lgrn::CompactCount>;
+    RefCount_t refCounts;
+
+    std::vector<RefCount_t::Owner_t> owners;
+    for (int i = 0; i < 1000; ++i)
+    {
+        owners.push_back(refCounts.ref_add(Id{5}));
+    }
+    RefCount_t::Owner_t other = refCounts.ref_add(Id{6});
+
+    EXPECT_EQ(refCounts[5], 1000);
+    EXPECT_EQ(refCounts[6], 1);
+    EXPECT_EQ(refCounts.spilled_count(), 1);
+
+    while (owners.size() > 1)
+    {
+        refCounts.ref_release(std::move(owners.back()));
+        owners.pop_back();
+    }
+
+    EXPECT_EQ(refCounts[5], 1);
+    EXPECT_EQ(refCounts.spilled_count(), 0);
+    EXPECT_TRUE(refCounts.zeros().empty());
+
+    refCounts.ref_release(std::move(owners.back()));
+    refCounts.ref_release(std::move(other));
+
+    auto const expected = {Id{5}, Id{6}};
+    EXPECT_TRUE(std::equal(expected.begin(), expected.end(), refCounts.zeros().begin()));
+    EXPECT_TRUE(refCounts.only_zeros_remaining(0));
+}
+
+// Add and release references for a whole range of IDs at once
+TEST(IdRefCount, Many)
+{
+    using RefCount_t = lgrn::IdRefCount<Id>;
+    RefCount_t refCounts;
+
+    std::vector<Id> const ids{Id{3}, Id{500}, Id{3}, Id{7}, Id{64}};
+    std::vector<RefCount_t::Owner_t> owners(ids.size());
+
+    auto const outLast = refCounts.ref_add_many(ids.begin(), ids.end(), owners.begin());
+
+    ASSERT_EQ(outLast, owners.end());
+    ASSERT_GE(refCounts.size(), 501);
+    EXPECT_EQ(refCounts[3], 2);
+    EXPECT_EQ(refCounts[500], 1);
+    EXPECT_TRUE(std::equal(ids.begin(), ids.end(), owners.begin()));
+
+    refCounts.ref_release_many(owners.begin(), owners.end());
+
+    EXPECT_TRUE(std::none_of(owners.begin(), owners.end(),
+                             [] (RefCount_t::Owner_t const& owner) { return owner.has_value(); }));
+    EXPECT_EQ(refCounts.zeros().size(), 4);
+    EXPECT_TRUE(refCounts.only_zeros_remaining(0));
+}
+
+// Many threads adding and releasing references to the same few IDs
+TEST(AtomicIdRefCount, MultiThreaded)
+{
+    using RefCount_t = lgrn::AtomicIdRefCount<Id>;
+
+    constexpr int const sc_threads      = 8;
+    constexpr int const sc_repetitions  = 2000;
+    constexpr int const sc_ids          = 100;
+
+    RefCount_t refCounts{sc_ids};
+
+    // Keep one reference to ID 0 alive for the whole test
+    RefCount_t::Owner_t keepAlive = refCounts.ref_add(Id{0});
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < sc_threads; ++i)
+    {
+        threads.emplace_back([&refCounts] ()
+        {
+            std::vector<RefCount_t::Owner_t> owners;
+            owners.reserve(sc_ids);
+            for (int rep = 0; rep < sc_repetitions; ++rep)
+            {
+                for (int id = 0; id < sc_ids; ++id)
+                {
+                    owners.push_back(refCounts.ref_add(Id(id)));
+                }
+                for (RefCount_t::Owner_t &rOwner : owners)
+                {
+                    refCounts.ref_release(std::move(rOwner));
+                }
+                owners.clear();
+            }
+        });
+    }
+
+    for (std::thread &rThread : threads)
+    {
+        rThread.join();
+    }
+
+    EXPECT_EQ(refCounts.count(Id{0}), 1);
+
+    std::vector<Id> zeros;
+    refCounts.collect_zeros([&zeros] (Id id) { zeros.push_back(id); });
+
+    // Every ID except 0 must have reached zero at least once
+    ASSERT_EQ(zeros.size(), sc_ids - 1);
+    EXPECT_EQ(zeros.front(), Id{1});
+    EXPECT_EQ(zeros.back(), Id{sc_ids - 1});
+
+    // Collecting again finds nothing new
+    zeros.clear();
+    refCounts.collect_zeros([&zeros] (Id id) { zeros.push_back(id); });
+    EXPECT_TRUE(zeros.empty());
+
+    refCounts.ref_release(std::move(keepAlive));
+    refCounts.collect_zeros([&zeros] (Id id) { zeros.push_back(id); });
+    ASSERT_EQ(zeros.size(), 1);
+    EXPECT_EQ(zeros.front(), Id{0});
+    EXPECT_TRUE(refCounts.only_zeros_remaining());
+}
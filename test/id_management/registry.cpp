@@ -136,3 +136,28 @@ TEST(IdRegistry, RandomCreationAndDeletion)
         EXPECT_EQ( idSet.size(), registry.size() );
     }
 }
+
+// Word occupancy and memory usage
+TEST(IdRegistry, MemoryStats)
+{
+    lgrn::IdRegistryStl<Id, true> registry;
+    registry.reserve(256);
+
+    std::array<Id, 100> ids;
+    registry.create(ids.begin(), ids.end());
+
+    lgrn::MemoryStats const stats = registry.memory_stats();
+
+    // IDs 0..99 fill the first word, part of the second, and none of the last two
+    EXPECT_EQ(stats.m_wordsFull,    1);
+    EXPECT_EQ(stats.m_wordsPartial, 1);
+    EXPECT_EQ(stats.m_wordsEmpty,   2);
+    EXPECT_EQ(stats.m_bytesUsed,    4 * sizeof(std::uint64_t));
+    EXPECT_GE(stats.m_bytesReserved, stats.m_bytesUsed);
+
+    auto const histogram = lgrn::word_occupancy_histogram<false>(
+            registry.vec().data(), registry.vec().data() + registry.vec().size());
+    EXPECT_EQ(histogram[64], 1);
+    EXPECT_EQ(histogram[36], 1);
+    EXPECT_EQ(histogram[0],  2);
+}
@@ -3,10 +3,12 @@
  * SPDX-FileCopyrightText: 2021 Neal Nicdao <chrisnicdao0@gmail.com>
  */
 #include <longeron/containers/intarray_multimap.hpp>
+#include <longeron/containers/intarray_multimap_transpose.hpp>
 #include <longeron/id_management/registry_stl.hpp>
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <array>
 #include <random>
 #include <unordered_map>
@@ -123,6 +125,18 @@ TEST(IntArrayMultiMap, Ownership)
         EXPECT_EQ(dataC[0].use_count(), 3);
         EXPECT_EQ(dataC[4].use_count(), 3);
 
+        {
+            IntArrayMultiMap<id_t, Shared_t> copy{multimap};
+
+            // copy doubles the number of users held by the container
+            EXPECT_EQ(dataA.use_count(), 3);
+            EXPECT_EQ(dataB[0].use_count(), 5);
+            EXPECT_EQ(dataC[4].use_count(), 5);
+        }
+
+        EXPECT_EQ(dataA.use_count(), 2);
+        EXPECT_EQ(dataC[4].use_count(), 3);
+
     } // destruct multimap
 
     EXPECT_EQ(dataA.use_count(), 1);
@@ -132,6 +146,139 @@ TEST(IntArrayMultiMap, Ownership)
     EXPECT_EQ(dataC[4].use_count(), 1);
 }
 
+// Copies are independent from the original, and packed copies have no holes
+TEST(IntArrayMultiMap, Copy)
+{
+    IntArrayMultiMap<id_t, int> multimap(16, 4);
+
+    multimap.emplace(0, {1, 2});
+    multimap.emplace(1, {3, 4, 5});
+    multimap.emplace(2, {6, 7, 8, 9});
+    multimap.erase(1);
+
+    IntArrayMultiMap<id_t, int> copy{multimap};
+    IntArrayMultiMap<id_t, int> packed = multimap.packed_copy();
+
+    multimap[0][0] = 42;
+    multimap.erase(2);
+
+    for (IntArrayMultiMap<id_t, int> const* pMap : {&copy, &packed})
+    {
+        EXPECT_TRUE(pMap->contains(0));
+        EXPECT_FALSE(pMap->contains(1));
+        EXPECT_TRUE(pMap->contains(2));
+        EXPECT_EQ((*pMap)[0][0], 1);
+        EXPECT_EQ((*pMap)[2][3], 9);
+        EXPECT_EQ(pMap->data_size(), 6);
+    }
+
+    // Packed copy places 2 right after 0
+    EXPECT_EQ(&packed[0][0] + 2, &packed[2][0]);
+
+    // Move and copy assign
+    multimap = std::move(packed);
+    EXPECT_EQ(multimap[2][0], 6);
+    copy = multimap;
+    EXPECT_EQ(copy[2][0], 6);
+}
+
+// Iterate partitions in the order they are stored in memory
+TEST(IntArrayMultiMap, ForEachPartition)
+{
+    IntArrayMultiMap<id_t, int> multimap(16, 8);
+
+    multimap.emplace(5, {1, 2});
+    multimap.emplace(2, {3, 4, 5});
+    multimap.emplace(7, {6});
+    multimap.emplace(0, {7, 8});
+    multimap.erase(2);
+
+    std::vector<id_t> ids;
+    std::vector<int> values;
+    multimap.for_each_partition([&] (id_t id, lgrn::Span<int> data)
+    {
+        ids.push_back(id);
+        values.insert(values.end(), data.begin(), data.end());
+    });
+
+    EXPECT_EQ(ids,    std::vector<id_t>({5, 7, 0}));
+    EXPECT_EQ(values, std::vector<int>({1, 2, 6, 7, 8}));
+
+    EXPECT_FALSE(multimap.is_packed());
+    multimap.pack();
+    ASSERT_TRUE(multimap.is_packed());
+
+    auto const all = multimap.data_packed();
+    EXPECT_TRUE(std::equal(all.begin(), all.end(), values.begin(), values.end()));
+}
+
+// Invert a relationship, results must be the same no matter how many chunks are used
+TEST(IntArrayMultiMap, Transpose)
+{
+    IntArrayMultiMap<id_t, id_t> parentToChildren(64, 16);
+
+    parentToChildren.emplace(0, {1, 2, 3});
+    parentToChildren.emplace(3, {4, 5});
+    parentToChildren.emplace(7, {2, 6, 2});
+    parentToChildren.emplace(9, {});
+
+    auto const check = [] (auto const& childToParents)
+    {
+        auto const parents_of = [&childToParents] (id_t child)
+        {
+            auto const span = childToParents[child];
+            return std::vector<id_t>(span.begin(), span.end());
+        };
+
+        EXPECT_FALSE(childToParents.contains(0));
+        EXPECT_EQ(parents_of(1), std::vector<id_t>({0}));
+        EXPECT_EQ(parents_of(2), std::vector<id_t>({0, 7, 7}));
+        EXPECT_EQ(parents_of(4), std::vector<id_t>({3}));
+        EXPECT_EQ(parents_of(6), std::vector<id_t>({7}));
+        EXPECT_FALSE(childToParents.contains(7));
+    };
+
+    IntArrayMultiMap<id_t, id_t> const serial = lgrn::transpose(parentToChildren, 8);
+    check(serial);
+    EXPECT_EQ(serial.data_size(), 8);
+    EXPECT_TRUE(serial.is_packed());
+
+    lgrn::ThreadPool pool{3};
+    for (std::size_t chunks : {0u, 1u, 2u, 3u, 16u})
+    {
+        IntArrayMultiMap<id_t, id_t> const childToParents
+                = lgrn::transpose(parentToChildren, 8, pool, chunks);
+        check(childToParents);
+        EXPECT_EQ(childToParents.data_size(), 8);
+        EXPECT_TRUE(childToParents.is_packed());
+    }
+
+    // Allocator and INLINE_N carry over to the output
+    IntArrayMultiMap<id_t, id_t, std::allocator<id_t>, 2> inlineMap(64, 16);
+    for (id_t const parent : {0, 3, 7, 9})
+    {
+        auto const span = parentToChildren[parent];
+        inlineMap.emplace(parent, span.begin(), span.end());
+    }
+
+    IntArrayMultiMap<id_t, id_t, std::allocator<id_t>, 2> const inlineOut
+            = lgrn::transpose(inlineMap, 8, pool, 3);
+    check(inlineOut);
+
+    // Source partitions that are all inline can still transpose into ones that aren't
+    IntArrayMultiMap<id_t, id_t, std::allocator<id_t>, 2> allInline(64, 16);
+    for (id_t a = 0; a < 10; ++a)
+    {
+        allInline.emplace(a, {5u});
+    }
+    EXPECT_EQ(allInline.data_size(), 0);
+
+    auto const allInlineOut = lgrn::transpose(allInline, 8);
+    EXPECT_EQ(allInlineOut.data_size(), 10);
+    EXPECT_EQ(allInlineOut[5].size(), 10);
+    EXPECT_EQ(allInlineOut[5][9], 9);
+}
+
 using Unique_t = std::unique_ptr<float>;
 
 TEST(IntArrayMultiMap, UniqueOwnership)
@@ -156,6 +303,138 @@ TEST(IntArrayMultiMap, UniqueOwnership)
     EXPECT_EQ(*multimap[1][0], 69.0f);
 }
 
+// Small partitions stored inline within the per-ID descriptor, alongside regular ones
+TEST(IntArrayMultiMap, Inline)
+{
+    using Inline_t = IntArrayMultiMap<id_t, int, std::allocator<int>, 3>;
+
+    Inline_t multimap(16, 8);
+
+    multimap.emplace(0, {1, 2, 3});
+    multimap.emplace(1, {4, 5, 6, 7, 8});
+    multimap.emplace(2, {9});
+    multimap.emplace(3, 0);
+
+    // Only partition 1 is too large, and goes into the data buffer
+    EXPECT_EQ(multimap.data_size(), 5);
+    EXPECT_EQ(multimap.ids_count(), 4);
+
+    EXPECT_EQ(multimap[0].size(), 3);
+    EXPECT_EQ(multimap[0][2], 3);
+    EXPECT_EQ(multimap[1][4], 8);
+    EXPECT_EQ(multimap[2][0], 9);
+    EXPECT_TRUE(multimap.contains(3));
+    EXPECT_EQ(multimap[3].size(), 0);
+    EXPECT_EQ(multimap[7].size(), 0);
+    EXPECT_EQ(multimap[100].size(), 0);
+
+    // Inline data moves along with the descriptors
+    multimap.ids_reserve(1000);
+    EXPECT_EQ(multimap[0][1], 2);
+
+    Inline_t const copy = multimap.packed_copy();
+
+    multimap.erase(0);
+    multimap.erase(1);
+    EXPECT_FALSE(multimap.contains(0));
+    EXPECT_EQ(multimap[0].size(), 0);
+    EXPECT_EQ(multimap.data_size(), 0);
+
+    std::vector<id_t> const toErase{2, 3};
+    multimap.erase_many(toErase.begin(), toErase.end());
+    EXPECT_EQ(multimap.ids_count(), 0);
+
+    // Buffer partitions are visited first, then inline partitions
+    std::vector<id_t> visited;
+    copy.for_each_partition([&visited] (id_t id, lgrn::Span<int const>)
+    {
+        visited.push_back(id);
+    });
+    EXPECT_EQ(visited, (std::vector<id_t>{1, 0, 2, 3}));
+    EXPECT_EQ(copy[0][0], 1);
+    EXPECT_EQ(copy[1][0], 4);
+}
+
+// Every partition number must be usable when inline storage is disabled, including the largest
+// one below the null value
+TEST(IntArrayMultiMap, FullRangeOfPartitionNumbers)
+{
+    IntArrayMultiMap<std::uint8_t, int> multimap(255, 255);
+
+    for (int id = 0; id < 255; ++id)
+    {
+        multimap.emplace(std::uint8_t(id), {id});
+    }
+
+    multimap.erase(254);
+    EXPECT_EQ(multimap.data_size(), 254);
+    EXPECT_FALSE(multimap.contains(254));
+
+    multimap.pack();
+    multimap.emplace(254, {7});
+    EXPECT_EQ(multimap[254][0], 7);
+    EXPECT_EQ(multimap[253][0], 253);
+}
+
+// Inline partitions erased in any order are still visited exactly once
+TEST(IntArrayMultiMap, InlineEraseOrder)
+{
+    IntArrayMultiMap<id_t, int, std::allocator<int>, 2> multimap(16, 8);
+
+    for (id_t id = 0; id < 8; ++id)
+    {
+        multimap.emplace(id, {int(id)});
+    }
+
+    multimap.erase(0);
+    multimap.erase(7);
+    std::vector<id_t> const toErase{3, 4};
+    multimap.erase_many(toErase.begin(), toErase.end());
+    multimap.emplace(3, {30});
+
+    std::vector<id_t> visited;
+    multimap.for_each_partition([&visited, &multimap] (id_t id, lgrn::Span<int> data)
+    {
+        visited.push_back(id);
+        EXPECT_EQ(data.data(), multimap[id].data());
+    });
+    std::sort(visited.begin(), visited.end());
+    EXPECT_EQ(visited, (std::vector<id_t>{1, 2, 3, 5, 6}));
+    EXPECT_EQ(multimap.ids_count(), 5);
+    EXPECT_EQ(multimap[3][0], 30);
+}
+
+// Holes left behind by erasing are visible in memory stats until packed
+TEST(IntArrayMultiMap, MemoryStats)
+{
+    IntArrayMultiMap<id_t, int> multimap(64, 8);
+
+    multimap.emplace(0, 4);
+    multimap.emplace(1, 8);
+    multimap.emplace(2, 4);
+    multimap.emplace(3, 2);
+    multimap.emplace(4, 4);
+
+    multimap.erase(1);
+    multimap.erase(3);
+
+    lgrn::MemoryStats stats = multimap.memory_stats();
+    EXPECT_EQ(stats.m_holeCount, 2);
+    EXPECT_EQ(stats.m_largestHoleBytes, 8 * sizeof(int));
+    EXPECT_GE(stats.m_bytesReserved, 64 * sizeof(int));
+    EXPECT_GE(stats.bytes_unused(), (64 - 12) * sizeof(int));
+
+    multimap.pack();
+
+    stats = multimap.memory_stats();
+    EXPECT_EQ(stats.m_holeCount, 0);
+    EXPECT_EQ(stats.m_largestHoleBytes, 0);
+
+    // Summing multiple containers
+    lgrn::MemoryStats const sum = lgrn::sum_memory_stats(multimap, multimap, std::vector<int>(4));
+    EXPECT_EQ(sum.m_bytesUsed, stats.m_bytesUsed * 2 + 4 * sizeof(int));
+}
+
 // Repetitively delete and create random-sized partitions
 // Compare against an std::unordered_map< ..., std::vector<...> >
 TEST(IntArrayMultiMap, RandomCreationAndDeletion)
@@ -242,3 +521,81 @@ TEST(IntArrayMultiMap, RandomCreationAndDeletion)
 }
 
 
+
+// Erase in batches and individually, interleaved with partial packs that leave holes behind.
+// Compare against an std::unordered_map< ..., std::vector<...> >
+TEST(IntArrayMultiMap, EraseManyAndPartialPack)
+{
+    constexpr int const sc_seed         = 420;
+    constexpr int const sc_repetitions  = 64;
+    constexpr id_t const sc_idMax       = 256;
+    constexpr int const sc_maxMoves     = 16;
+
+    std::mt19937 gen(sc_seed);
+    std::uniform_int_distribution<int> distPrtnSize(1, 10);
+    std::uniform_int_distribution<int> distFlip(0, 1);
+
+    std::unordered_map< id_t, std::vector<int> > control;
+    // Enough space to go 4 repetitions without fully packing
+    IntArrayMultiMap<id_t, int> multimap(sc_idMax * 10 * 4, sc_idMax);
+
+    for (int i = 0; i < sc_repetitions; i ++)
+    {
+        if (i % 4 == 0)
+        {
+            multimap.pack();
+        }
+
+        for (id_t id = 0; id < sc_idMax; ++id)
+        {
+            if ( ! multimap.contains(id) && distFlip(gen) == 1 )
+            {
+                int const size = distPrtnSize(gen);
+                std::vector<int> &rValues = control[id];
+                int *pData = multimap.emplace(id, size);
+                for (int j = 0; j < size; ++j)
+                {
+                    pData[j] = int(gen());
+                    rValues.push_back(pData[j]);
+                }
+            }
+        }
+
+        std::vector<id_t> toErase;
+        for (id_t id = 0; id < sc_idMax; ++id)
+        {
+            if ( multimap.contains(id) && distFlip(gen) == 1 )
+            {
+                toErase.push_back(id);
+                control.erase(id);
+            }
+        }
+
+        if (i % 2 == 0)
+        {
+            multimap.erase_many(toErase.begin(), toErase.end());
+        }
+        else
+        {
+            // Erase in reverse to merge holes from the right
+            for (auto it = toErase.rbegin(); it != toErase.rend(); ++it)
+            {
+                multimap.erase(*it);
+            }
+        }
+
+        multimap.pack(sc_maxMoves);
+
+        ASSERT_EQ(multimap.ids_count(), control.size());
+        for (auto const & [id, controlValues] : control)
+        {
+            auto const values = multimap[id];
+            ASSERT_EQ(values.size(), controlValues.size());
+            EXPECT_TRUE(std::equal(values.begin(), values.end(), controlValues.begin()));
+        }
+    }
+
+    multimap.pack();
+    EXPECT_TRUE(multimap.is_packed());
+    EXPECT_EQ(multimap.data_packed().size(), multimap.data_size());
+}
@@ -0,0 +1,138 @@
+/**
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: 2026 Neal Nicdao <chrisnicdao0@gmail.com>
+ */
+#include <longeron/containers/intarray_multimap_soa.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+using lgrn::IntArrayMultiMapSoA;
+
+using id_t = unsigned int;
+
+// Columns stay consistent with each other through erase, pack, and reallocation
+TEST(IntArrayMultiMapSoA, Basic)
+{
+    IntArrayMultiMapSoA<id_t, int, float, std::unique_ptr<int>> multimap(16, 4);
+
+    auto const emplace = [&multimap] (id_t id, std::size_t size)
+    {
+        auto [pInts, pFloats, pUniques] = multimap.emplace(id, size);
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            pInts[i]    = int(id * 10 + i);
+            pFloats[i]  = float(id) + 0.5f;
+            pUniques[i] = std::make_unique<int>(int(id));
+        }
+    };
+
+    emplace(0, 2);
+    emplace(1, 3);
+    emplace(2, 4);
+
+    EXPECT_EQ(multimap.data_size(), 9);
+    EXPECT_EQ(multimap.column<0>(1)[2], 12);
+    EXPECT_EQ(multimap.column<1>(1)[0], 1.5f);
+
+    multimap.erase(1);
+    EXPECT_FALSE(multimap.contains(1));
+    EXPECT_EQ(multimap.column<0>(1).size(), 0);
+
+    multimap.pack();
+
+    EXPECT_EQ(multimap.column<0>(2)[3], 23);
+    EXPECT_EQ(multimap.column<1>(2)[3], 2.5f);
+    EXPECT_EQ(*multimap.column<2>(2)[3], 2);
+
+    // Partition 2 moved right after 0 in every column
+    EXPECT_EQ(&multimap.column<0>(0)[0] + 2, &multimap.column<0>(2)[0]);
+    EXPECT_EQ(&multimap.column<2>(0)[0] + 2, &multimap.column<2>(2)[0]);
+
+    multimap.data_reserve(64);
+    emplace(3, 40);
+
+    EXPECT_EQ(multimap.column<0>(0)[1], 1);
+    EXPECT_EQ(*multimap.column<2>(2)[0], 2);
+    EXPECT_EQ(multimap.column<1>(3)[39], 3.5f);
+
+    auto const& multimapConst = multimap;
+    EXPECT_EQ(multimapConst.column<0>(3)[39], 69);
+}
+
+// Data capacity is independent of the ID type's range
+TEST(IntArrayMultiMapSoA, SmallIdType)
+{
+    IntArrayMultiMapSoA<std::uint8_t, int, float> multimap(300, 4);
+    EXPECT_EQ(multimap.data_capacity(), 300);
+
+    multimap.emplace(0, 280);
+    multimap.data_reserve(70000);
+    EXPECT_EQ(multimap.data_capacity(), 70000);
+
+    std::get<0>(multimap.emplace(1, 69000))[68999] = 42;
+    EXPECT_EQ(multimap.column<0>(1)[68999], 42);
+    EXPECT_EQ(multimap.data_size(), 69280);
+}
+
+// Repetitively delete and create random-sized partitions, compare against std::unordered_map
+TEST(IntArrayMultiMapSoA, RandomCreationAndDeletion)
+{
+    constexpr int const sc_seed         = 69;
+    constexpr int const sc_repetitions  = 32;
+    constexpr id_t const sc_idMax       = 128;
+
+    std::mt19937 gen(sc_seed);
+    std::uniform_int_distribution<int> distPrtnSize(0, 10);
+    std::uniform_int_distribution<int> distFlip(0, 1);
+
+    std::unordered_map< id_t, std::vector<int> > control;
+    IntArrayMultiMapSoA<id_t, int, double> multimap(sc_idMax * 10, sc_idMax);
+
+    for (int i = 0; i < sc_repetitions; i ++)
+    {
+        for (id_t id = 0; id < sc_idMax; ++id)
+        {
+            if ( ! multimap.contains(id) && distFlip(gen) == 1 )
+            {
+                int const size = distPrtnSize(gen);
+                auto [pInts, pDoubles] = multimap.emplace(id, size);
+                std::vector<int> &rValues = control[id];
+                for (int j = 0; j < size; ++j)
+                {
+                    pInts[j] = int(gen());
+                    pDoubles[j] = double(pInts[j]) * 2.0;
+                    rValues.push_back(pInts[j]);
+                }
+            }
+        }
+
+        for (id_t id = 0; id < sc_idMax; ++id)
+        {
+            if ( multimap.contains(id) && distFlip(gen) == 1 )
+            {
+                multimap.erase(id);
+                control.erase(id);
+            }
+        }
+
+        multimap.pack();
+
+        for (auto const & [id, controlValues] : control)
+        {
+            auto const ints     = multimap.column<0>(id);
+            auto const doubles  = multimap.column<1>(id);
+            ASSERT_EQ(ints.size(), controlValues.size());
+            for (std::size_t j = 0; j < controlValues.size(); j ++)
+            {
+                EXPECT_EQ(ints[j], controlValues[j]);
+                EXPECT_EQ(doubles[j], double(controlValues[j]) * 2.0);
+            }
+        }
+    }
+}
@@ -0,0 +1,214 @@
+/**
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: 2026 Neal Nicdao <chrisnicdao0@gmail.com>
+ */
+#include <longeron/containers/partition_view.hpp>
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+using id_t = unsigned int;
+
+using View_t = lgrn::PartitionView<id_t, int>;
+
+// All arrays live in a single struct, as if placed in shared memory or a file
+struct Arena
+{
+    static constexpr std::size_t smc_ids = 64;
+
+    std::array<id_t, smc_ids * 2>                   m_partitionToId;
+    std::array<id_t, smc_ids>                       m_idToPartition;
+    std::array<View_t::DataSpan_t, smc_ids>         m_idToData;
+    std::array<View_t::Free_t, smc_ids>             m_free;
+    std::array<int, 1024>                           m_data;
+    View_t::State                                   m_state;
+
+    View_t view()
+    {
+        return View_t{{m_partitionToId.data(), m_partitionToId.size()},
+                      {m_idToPartition.data(), m_idToPartition.size()},
+                      {m_idToData.data(),      m_idToData.size()},
+                      {m_free.data(),          m_free.size()},
+                      {m_data.data(),          m_data.size()},
+                      m_state};
+    }
+};
+
+TEST(PartitionView, Basic)
+{
+    Arena arena;
+    View_t view = arena.view();
+    view.init();
+
+    view.emplace(0, {1, 2});
+    view.emplace(1, {3, 4, 5});
+    view.emplace(2, {6, 7, 8, 9});
+
+    EXPECT_TRUE(view.contains(1));
+    EXPECT_EQ(view[1][2], 5);
+    EXPECT_EQ(view.data_size(), 9);
+
+    view.erase(1);
+    EXPECT_FALSE(view.contains(1));
+
+    view.pack();
+
+    EXPECT_EQ(view[2][0], 6);
+    EXPECT_EQ(&view[0][0] + 2, &view[2][0]);
+
+    // Copying the arena copies the whole multimap
+    Arena copy = arena;
+    View_t copyView = copy.view();
+
+    EXPECT_EQ(copyView[2][3], 9);
+    EXPECT_EQ(copyView.ids_count(), 2);
+}
+
+// Repetitively delete and create random-sized partitions with partial packing
+TEST(PartitionView, RandomCreationAndDeletion)
+{
+    constexpr int const sc_seed         = 69;
+    constexpr int const sc_repetitions  = 64;
+
+    std::mt19937 gen(sc_seed);
+    std::uniform_int_distribution<int> distPrtnSize(0, 8);
+    std::uniform_int_distribution<int> distFlip(0, 3);
+
+    Arena arena;
+    View_t view = arena.view();
+    view.init();
+
+    std::unordered_map< id_t, std::vector<int> > control;
+
+    for (int i = 0; i < sc_repetitions; i ++)
+    {
+        for (id_t id = 0; id < Arena::smc_ids; ++id)
+        {
+            if (view.contains(id) && distFlip(gen) == 0)
+            {
+                view.erase(id);
+                control.erase(id);
+            }
+        }
+
+        // pack just enough so there's room for all IDs to fit
+        view.pack(16);
+        if (view.state().m_freeLast.m_partitionNum >= Arena::smc_ids)
+        {
+            view.pack();
+        }
+
+        for (id_t id = 0; id < Arena::smc_ids; ++id)
+        {
+            if ( ! view.contains(id) && distFlip(gen) == 0 )
+            {
+                std::vector<int> values(distPrtnSize(gen));
+                std::generate(values.begin(), values.end(), [&gen] { return int(gen()); });
+                view.emplace(id, values.begin(), values.end());
+                control.emplace(id, std::move(values));
+            }
+        }
+
+        ASSERT_EQ(view.ids_count(), control.size());
+        for (auto const & [id, controlValues] : control)
+        {
+            auto const values = view[id];
+            ASSERT_TRUE(std::equal(values.begin(), values.end(),
+                                   controlValues.begin(), controlValues.end()));
+        }
+    }
+}
+
+// Adjacent holes merge, and erase fails instead of overflowing a full free list
+TEST(PartitionView, FullFreeList)
+{
+    Arena arena;
+    View_t view{{arena.m_partitionToId.data(), arena.m_partitionToId.size()},
+                {arena.m_idToPartition.data(), arena.m_idToPartition.size()},
+                {arena.m_idToData.data(),      arena.m_idToData.size()},
+                {arena.m_free.data(),          2},
+                {arena.m_data.data(),          arena.m_data.size()},
+                arena.m_state};
+    view.init();
+
+    for (id_t id = 0; id < 8; ++id)
+    {
+        view.emplace(id, {int(id), int(id)});
+    }
+
+    EXPECT_TRUE(view.erase(1));
+    EXPECT_TRUE(view.erase(3));
+    EXPECT_EQ(view.state().m_freeCount, 2);
+
+    // No room for a separate hole, nothing changes
+    EXPECT_FALSE(view.erase(5));
+    EXPECT_TRUE(view.contains(5));
+    EXPECT_EQ(view.ids_count(), 6);
+
+    // Merges with the hole on its left
+    EXPECT_TRUE(view.erase(4));
+    EXPECT_EQ(view.state().m_freeCount, 2);
+
+    // Merges holes on both sides into one
+    EXPECT_TRUE(view.erase(2));
+    EXPECT_EQ(view.state().m_freeCount, 1);
+
+    // Merges with the last free partition
+    EXPECT_TRUE(view.erase(7));
+    EXPECT_EQ(view.state().m_freeCount, 1);
+
+    // Earlier failed erase works now, merging with the hole on its left
+    EXPECT_TRUE(view.erase(5));
+    EXPECT_EQ(view.state().m_freeCount, 1);
+    EXPECT_EQ(view.data_size(), 4);
+
+    view.pack();
+    EXPECT_EQ(view.state().m_freeCount, 0);
+    EXPECT_EQ(view[0][1], 0);
+    EXPECT_EQ(view[6][0], 6);
+    EXPECT_EQ(&view[0][0] + 2, &view[6][0]);
+}
+
+// The arrays can't grow, emplace fails without changing anything once they are full
+TEST(PartitionView, Full)
+{
+    Arena arena;
+    View_t view{{arena.m_partitionToId.data(), 4},
+                {arena.m_idToPartition.data(), arena.m_idToPartition.size()},
+                {arena.m_idToData.data(),      arena.m_idToData.size()},
+                {arena.m_free.data(),          arena.m_free.size()},
+                {arena.m_data.data(),          8},
+                arena.m_state};
+    view.init();
+
+    ASSERT_NE(view.emplace(0, {1, 2, 3}), nullptr);
+    ASSERT_NE(view.emplace(1, {4, 5, 6}), nullptr);
+
+    // Out of data space
+    EXPECT_EQ(view.emplace(2, {7, 8, 9}), nullptr);
+    EXPECT_EQ(view.emplace(2, 3), nullptr);
+    EXPECT_FALSE(view.contains(2));
+    EXPECT_EQ(view.ids_count(), 2);
+    EXPECT_EQ(view.data_size(), 6);
+
+    // Exactly fits
+    ASSERT_NE(view.emplace(2, {7}), nullptr);
+    ASSERT_NE(view.emplace(3, {8}), nullptr);
+
+    // Out of partition numbers, even with no data
+    EXPECT_EQ(view.emplace(4, 0), nullptr);
+    EXPECT_FALSE(view.contains(4));
+
+    // Packing after erasing gives back both
+    EXPECT_TRUE(view.erase(1));
+    EXPECT_EQ(view.emplace(4, {10, 11, 12}), nullptr);
+    view.pack();
+    ASSERT_NE(view.emplace(4, {10, 11, 12}), nullptr);
+    EXPECT_EQ(view[4][2], 12);
+    EXPECT_EQ(view[3][0], 8);
+    EXPECT_EQ(view.data_size(), 8);
+}
@@ -0,0 +1,152 @@
+/**
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: 2026 Neal Nicdao <chrisnicdao0@gmail.com>
+ */
+#include <longeron/tasks/parallel_for.hpp>
+#include <longeron/tasks/system_scheduler.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Systems only wait on earlier systems that conflict with their reads and writes
+TEST(Tasks, SchedulerDependencies)
+{
+    std::vector<int> positions;
+    std::vector<int> velocities;
+    std::vector<int> colors;
+
+    lgrn::SystemScheduler scheduler;
+
+    auto const move     = scheduler.add("move",     {}, lgrn::SystemAccess{}.read(velocities).write(positions));
+    auto const paint    = scheduler.add("paint",    {}, lgrn::SystemAccess{}.write(colors));
+    auto const accel    = scheduler.add("accel",    {}, lgrn::SystemAccess{}.write(velocities));
+    auto const draw     = scheduler.add("draw",     {}, lgrn::SystemAccess{}.read(positions, colors));
+    auto const readVel  = scheduler.add("readVel",  {}, lgrn::SystemAccess{}.read(velocities));
+
+    EXPECT_TRUE(scheduler.dependencies(move).empty());
+    EXPECT_TRUE(scheduler.dependencies(paint).empty());
+    EXPECT_EQ(scheduler.dependencies(accel), std::vector<std::size_t>({move}));  // write after read
+    EXPECT_EQ(scheduler.dependencies(draw),  std::vector<std::size_t>({move, paint}));
+    EXPECT_EQ(scheduler.dependencies(readVel), std::vector<std::size_t>({accel}));
+}
+
+// Running in parallel must give the same result as running in order
+TEST(Tasks, SchedulerRun)
+{
+    lgrn::ThreadPool pool{4};
+
+    int a = 0;
+    int b = 0;
+    int sum = 0;
+    std::vector<int> order;
+    std::mutex orderMutex;
+
+    auto record = [&order, &orderMutex] (int id)
+    {
+        std::lock_guard<std::mutex> lock{orderMutex};
+        order.push_back(id);
+    };
+
+    lgrn::SystemScheduler scheduler;
+    scheduler.add("setA",   [&] { a = 3;        record(0); }, lgrn::SystemAccess{}.write(a));
+    scheduler.add("setB",   [&] { b = 4;        record(1); }, lgrn::SystemAccess{}.write(b));
+    scheduler.add("sum",    [&] { sum = a + b;  record(2); }, lgrn::SystemAccess{}.read(a, b).write(sum));
+    scheduler.add("double", [&] { a *= 2;       record(3); }, lgrn::SystemAccess{}.write(a));
+
+    for (int frame = 0; frame < 100; ++frame)
+    {
+        order.clear();
+        scheduler.run(pool);
+
+        EXPECT_EQ(sum, 7);
+        EXPECT_EQ(a, 6);
+        ASSERT_EQ(order.size(), 4);
+
+        auto const pos = [&order] (int id) { return std::find(order.begin(), order.end(), id) - order.begin(); };
+        EXPECT_LT(pos(0), pos(2));
+        EXPECT_LT(pos(1), pos(2));
+        EXPECT_LT(pos(2), pos(3));
+    }
+}
+
+// A pool with no threads runs everything on the waiting thread
+TEST(Tasks, NoThreads)
+{
+    lgrn::ThreadPool pool{0};
+
+    int value = 0;
+    lgrn::SystemScheduler scheduler;
+    scheduler.add("a", [&] { value += 1; }, lgrn::SystemAccess{}.write(value));
+    scheduler.add("b", [&] { value *= 5; }, lgrn::SystemAccess{}.write(value));
+    scheduler.run(pool);
+
+    EXPECT_EQ(value, 5);
+}
+
+TEST(Tasks, ParallelForEach)
+{
+    lgrn::ThreadPool pool{4};
+
+    lgrn::IdSetStl<std::size_t> set;
+    set.resize(10000);
+    std::size_t expectSum = 0;
+    for (std::size_t i = 0; i < 10000; i += 3)
+    {
+        set.insert(i);
+        expectSum += i;
+    }
+
+    std::atomic<std::size_t> sum{0};
+    std::atomic<std::size_t> count{0};
+    lgrn::parallel_for_each(pool, set, 4, [&sum, &count] (std::size_t id)
+    {
+        sum.fetch_add(id, std::memory_order_relaxed);
+        count.fetch_add(1, std::memory_order_relaxed);
+    });
+
+    EXPECT_EQ(sum.load(), expectSum);
+    EXPECT_EQ(count.load(), set.size());
+
+    // Nested inside a system
+    std::atomic<std::size_t> nestedCount{0};
+    lgrn::SystemScheduler scheduler;
+    scheduler.add("nested", [&] ()
+    {
+        lgrn::parallel_for_each(pool, set, 1, [&nestedCount] (std::size_t)
+        {
+            nestedCount.fetch_add(1, std::memory_order_relaxed);
+        });
+    }, lgrn::SystemAccess{}.read(set));
+    scheduler.run(pool);
+
+    EXPECT_EQ(nestedCount.load(), set.size());
+}
+
+// Waiting on a long task sleeps instead of spinning
+TEST(Tasks, HelpUntilSleeps)
+{
+    lgrn::ThreadPool pool{1};
+
+    std::atomic<bool> done{false};
+    pool.submit([&done] ()
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        done.store(true);
+    });
+
+    // done() is checked once per loop iteration, and each time the waiter is woken
+    int checks = 0;
+    pool.help_until([&done, &checks] () { ++checks; return done.load(); });
+
+    EXPECT_TRUE(done.load());
+
+    // A few dozen brief spins then a single sleep, woken when the task finishes. Spinning for
+    // the whole 0.2s would check many thousands of times. The margin allows spurious wakeups.
+    EXPECT_LT(checks, 1000);
+}
@@ -0,0 +1,78 @@
+/**
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: 2026 Neal Nicdao <chrisnicdao0@gmail.com>
+ */
+#ifndef LGRN_TRACE_ENABLE
+    #define LGRN_TRACE_ENABLE
+#endif
+
+#include <longeron/containers/intarray_multimap.hpp>
+#include <longeron/id_management/registry_stl.hpp>
+#include <longeron/utility/trace_recorder.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <thread>
+
+static std::uint64_t counter_value(char const* name)
+{
+    for (auto const& [counterName, value] : lgrn::trace_counter_totals())
+    {
+        if (std::strcmp(counterName, name) == 0)
+        {
+            return value;
+        }
+    }
+    return 0;
+}
+
+// Counters are summed over all threads, including ones that already exited
+TEST(Trace, Counters)
+{
+    lgrn::trace_reset();
+
+    lgrn::IdRegistryStl<unsigned int> registry;
+    for (int i = 0; i < 1000; ++i)
+    {
+        (void)registry.create();
+    }
+
+    EXPECT_GT(counter_value("IdRegistryStl reallocations"), 0);
+    EXPECT_EQ(counter_value("BitViewIdRegistry::create calls"), 1000 + counter_value("IdRegistryStl reallocations"));
+
+    std::thread thread([] ()
+    {
+        for (int i = 0; i < 10; ++i)
+        {
+            LGRN_COUNTER_ADD("test counter", 2);
+        }
+    });
+    thread.join();
+    LGRN_COUNTER("test counter");
+
+    EXPECT_EQ(counter_value("test counter"), 21);
+
+    lgrn::IntArrayMultiMap<int, int> multimap(32, 4);
+    multimap.emplace(0, 8);
+    multimap.emplace(1, 8);
+    multimap.erase(0);
+    multimap.pack();
+    EXPECT_EQ(counter_value("IntArrayMultiMap pack moves"), 8);
+}
+
+TEST(Trace, ChromeJson)
+{
+    lgrn::trace_reset();
+
+    {
+        LGRN_TRACE("test event");
+        LGRN_COUNTER("test counter");
+    }
+
+    std::string const json = lgrn::trace_chrome_json();
+
+    EXPECT_EQ(json.rfind("{\"traceEvents\":[", 0), 0);
+    EXPECT_NE(json.find("\"name\":\"test event\",\"ph\":\"X\""), std::string::npos);
+    EXPECT_NE(json.find("\"test counter\":1"), std::string::npos);
+}